@@ -37,6 +37,13 @@ static void closeIfValid(int& fd) {
   }
 }
 
+// Between fork() and execve(): no iostreams, no allocation, no exit()
+static void childFail(const char* msg) {
+  ssize_t ignored = write(STDERR_FILENO, msg, std::strlen(msg));
+  (void)ignored;
+  _exit(EXIT_FAILURE);
+}
+
 CgiExecutor::CgiExecutor() {}
 
 CgiExecutor::~CgiExecutor() {}
@@ -49,11 +56,19 @@ CgiProcess* CgiExecutor::executeAsync(const HttpRequest& request,
   // Create communication pipes
   // pipe_in: parent writes request body to child stdin
   // pipe_out: parent reads CGI output from child stdout
+  // A body spooled to a temp file (client_body_buffer_size) needs no pipe_in:
+  // the child reads the file itself as stdin.
 
+  const RequestBody& requestBody = request.getBody();
+  const bool bodyInFile = requestBody.isInFile();
   int pipe_in[2] = {-1, -1};   // Parent → Child (request body)
   int pipe_out[2] = {-1, -1};  // Child → Parent (response)
 
-  if (pipe(pipe_in) == -1 || pipe(pipe_out) == -1) {
+  // O_CLOEXEC: with worker_threads > 1 another reactor may fork() while these
+  // pipes are open; its CGI must not inherit our ends (EOF would never come).
+  // dup2() in the child clears the flag on STDIN/STDOUT.
+  if ((!bodyInFile && pipe2(pipe_in, O_CLOEXEC) == -1) ||
+      pipe2(pipe_out, O_CLOEXEC) == -1) {
     std::cerr << "Failed to create pipes for CGI" << std::endl;
     closeIfValid(pipe_in[0]);
     closeIfValid(pipe_in[1]);
@@ -63,7 +78,8 @@ CgiProcess* CgiExecutor::executeAsync(const HttpRequest& request,
   }
 
   // Make pipes non-blocking
-  if (!setNonBlocking(pipe_in[1]) || !setNonBlocking(pipe_out[0])) {
+  if ((!bodyInFile && !setNonBlocking(pipe_in[1])) ||
+      !setNonBlocking(pipe_out[0])) {
     std::cerr << "Failed to set pipes non-blocking" << std::endl;
     closeIfValid(pipe_in[0]);
     closeIfValid(pipe_in[1]);
@@ -72,6 +88,48 @@ CgiProcess* CgiExecutor::executeAsync(const HttpRequest& request,
     return NULL;
   }
 
+  // Everything the child needs is built here, before fork(): with
+  // worker_threads > 1 another reactor may hold the malloc/iostream locks at
+  // fork time, so the child only makes async-signal-safe calls.
+  std::string script_dir = ".";
+  std::string script_name = script_path;
+  size_t last_slash = script_path.find_last_of('/');
+  if (last_slash != std::string::npos) {
+    script_dir = script_path.substr(0, last_slash);
+    script_name = script_path.substr(last_slash + 1);
+  }
+
+  std::map<std::string, std::string> env_map =
+      prepareEnvironment(request, script_path, serverConfig, clientIp);
+#ifdef DEBUG
+  for (std::map<std::string, std::string>::const_iterator it =
+           env_map.begin();
+       it != env_map.end(); ++it) {
+    std::cerr << "[CGI ENV] " << it->first << "=" << it->second << std::endl;
+  }
+#endif
+  std::vector<std::string> env_strings;
+  std::vector<char*> envp;
+  createEnvArray(env_map, env_strings, envp);
+
+  // Prepare arguments - use just the script filename after chdir
+  // Prefix with ./ for relative paths to work with /usr/bin/env and direct
+  // execution
+  std::vector<std::string> arg_strings;
+  if (!interpreter_path.empty()) arg_strings.push_back(interpreter_path);
+  arg_strings.push_back("./" + script_name);
+  std::vector<char*> args;
+  for (size_t i = 0; i < arg_strings.size(); ++i)
+    args.push_back(&arg_strings[i][0]);
+  args.push_back(NULL);
+
+#ifdef DEBUG
+  std::cerr << "[CGI CMD] Executing: " << args[0] << std::endl;
+  for (int i = 0; args[i] != NULL; ++i) {
+    std::cerr << "  [CGI ARG " << i << "] " << args[i] << std::endl;
+  }
+#endif
+
   pid_t pid = fork();
   if (pid == -1) {
     std::cerr << "Failed to fork CGI process" << std::endl;
@@ -83,85 +141,36 @@ CgiProcess* CgiExecutor::executeAsync(const HttpRequest& request,
   }
 
   if (pid == 0) {
-    // CHILD PROCESS
+    // CHILD PROCESS: only async-signal-safe calls from here to execve()
 
-    // Setup pipes for stdin/stdout
-    dup2(pipe_in[0], STDIN_FILENO);
+    // Setup pipes for stdin/stdout. The parent only uses pread/pwrite on
+    // the body file, rewinding the shared offset here is harmless.
+    if (bodyInFile) {
+      lseek(requestBody.fd(), 0, SEEK_SET);
+      dup2(requestBody.fd(), STDIN_FILENO);
+    } else {
+      dup2(pipe_in[0], STDIN_FILENO);
+    }
     dup2(pipe_out[1], STDOUT_FILENO);
 
-    close(pipe_in[0]);
-    close(pipe_in[1]);
+    if (pipe_in[0] >= 0) close(pipe_in[0]);
+    if (pipe_in[1] >= 0) close(pipe_in[1]);
     close(pipe_out[0]);
     close(pipe_out[1]);
 
-    // Extract script directory and filename
-    std::string script_dir = ".";
-    std::string script_name = script_path;
-    size_t last_slash = script_path.find_last_of('/');
-    if (last_slash != std::string::npos) {
-      script_dir = script_path.substr(0, last_slash);
-      script_name = script_path.substr(last_slash + 1);
-    }
-
     // Change to script directory
-    if (chdir(script_dir.c_str()) == -1) {
-      std::cerr << "chdir failed: " << std::strerror(errno) << std::endl;
-      std::exit(EXIT_FAILURE);
-    }
-
-    std::map<std::string, std::string> env_map =
-        prepareEnvironment(request, script_path, serverConfig, clientIp);
-#ifdef DEBUG
-    std::cout << "[CGI ENV] script=" << script_path << std::endl;
-    for (std::map<std::string, std::string>::const_iterator it =
-             env_map.begin();
-         it != env_map.end(); ++it) {
-      std::cerr << "[CGI ENV] " << it->first << "=" << it->second << std::endl;
-    }
-#endif
-    char** envp = createEnvArray(env_map);
+    if (chdir(script_dir.c_str()) == -1) childFail("chdir failed\n");
 
-    // Prepare arguments - use just the script filename after chdir
-    // Prefix with ./ for relative paths to work with /usr/bin/env and direct
-    // execution
-    std::string relative_script = "./" + script_name;
-
-    char* args[3];
-    args[0] = NULL;
-    args[1] = NULL;
-    args[2] = NULL;
-
-    if (!interpreter_path.empty()) {
-      args[0] = new char[interpreter_path.size() + 1];
-      std::strcpy(args[0], interpreter_path.c_str());
-
-      args[1] = new char[relative_script.size() + 1];
-      std::strcpy(args[1], relative_script.c_str());
-    } else {
-      args[0] = new char[relative_script.size() + 1];
-      std::strcpy(args[0], relative_script.c_str());
-    }
-
-    const char* exec_path = args[0];
-
-#ifdef DEBUG
-    std::cerr << "[CGI CMD] Executing: " << exec_path << std::endl;
-    for (int i = 0; args[i] != NULL; ++i) {
-      std::cerr << "  [CGI ARG " << i << "] " << args[i] << std::endl;
-    }
-#endif
-
-    execve(exec_path, args, envp);
+    execve(args[0], &args[0], &envp[0]);
 
     // If execve fails
-    std::cerr << "execve failed: " << std::strerror(errno) << std::endl;
-    std::exit(EXIT_FAILURE);
+    childFail("execve failed\n");
 
   } else {
     // PARENT PROCESS
 
     // Close unused pipe ends
-    close(pipe_in[0]);
+    closeIfValid(pipe_in[0]);
     close(pipe_out[1]);
 
     // Write request body to child stdin
@@ -169,8 +178,10 @@ CgiProcess* CgiExecutor::executeAsync(const HttpRequest& request,
 
     // Create CgiProcess tracker object
     // The Client will own this and clean it up when done
-    const std::vector<char>& requestBody = request.getBody();
-    std::string body(requestBody.begin(), requestBody.end());
+    // Only a body kept in memory (<= client_body_buffer_size) is copied
+    std::string body;
+    if (!bodyInFile && !requestBody.empty())
+      body.assign(requestBody.data(), requestBody.size());
     CgiProcess* proc =
         new CgiProcess(script_path, interpreter_path,
                        pipe_in[1],  // Write end
@@ -217,7 +228,7 @@ std::map<std::string, std::string> CgiExecutor::prepareEnvironment(
   std::ostringstream len;
   len << request.getBody().size();
   env["CONTENT_LENGTH"] = len.str();
-  std::string ct = request.getHeader("content-type");
+  std::string ct = request.getHeader(HTTP_HEADER_CONTENT_TYPE);
   if (!ct.empty()) env["CONTENT_TYPE"] = ct;
 
   // Client/Server Connection Information
@@ -235,10 +246,9 @@ std::map<std::string, std::string> CgiExecutor::prepareEnvironment(
   env["REDIRECT_STATUS"] = "200";
 
   // HTTP Request Headers as HTTP_* variables
-  const std::map<std::string, std::string>& headers = request.getHeaders();
-  for (std::map<std::string, std::string>::const_iterator it = headers.begin();
-       it != headers.end(); ++it) {
-    std::string key = it->first;
+  const HeaderTable& headers = request.getHeaders();
+  for (size_t h = 0; h < headers.size(); ++h) {
+    const std::string& key = headers.nameAt(h);
     std::string env_key = "HTTP_";
     for (size_t i = 0; i < key.length(); ++i) {
       char c = key[i];
@@ -247,25 +257,24 @@ std::map<std::string, std::string> CgiExecutor::prepareEnvironment(
       else
         env_key += toupper(c);
     }
-    env[env_key] = it->second;
+    env[env_key] = headers.valueAt(h);
   }
 
   return env;
 }
 
-char** CgiExecutor::createEnvArray(
-    const std::map<std::string, std::string>& env_map) {
-  char** envp = new char*[env_map.size() + 1];
-  int i = 0;
+void CgiExecutor::createEnvArray(
+    const std::map<std::string, std::string>& env_map,
+    std::vector<std::string>& storage, std::vector<char*>& envp) {
+  storage.clear();
   for (std::map<std::string, std::string>::const_iterator it = env_map.begin();
        it != env_map.end(); ++it) {
-    std::string s = it->first + "=" + it->second;
-    envp[i] = new char[s.size() + 1];
-    std::strcpy(envp[i], s.c_str());
-    i++;
+    storage.push_back(it->first + "=" + it->second);
   }
-  envp[i] = NULL;
-  return envp;
+  // Pointers taken once storage no longer reallocates
+  envp.clear();
+  for (size_t i = 0; i < storage.size(); ++i) envp.push_back(&storage[i][0]);
+  envp.push_back(NULL);
 }
 
 bool CgiExecutor::setNonBlocking(int fd) {
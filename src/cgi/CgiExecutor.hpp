@@ -10,6 +10,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "../config/ServerConfig.hpp"
 #include "../http/HttpRequest.hpp"
@@ -53,12 +54,17 @@ class CgiExecutor {
       const ServerConfig& serverConfig, const std::string& clientIp);
 
   /**
-   * Convert environment map to C-style array for execve
+   * Convert environment map to a NULL-terminated array for execve
+   *
+   * Built in the parent before fork(), so the child never allocates
    *
    * @param env_map: Environment variable map
-   * @return Allocated char** array (caller must free)
+   * @param storage: Owns the "KEY=value" strings
+   * @param envp: Receives pointers into storage, NULL-terminated
    */
-  char** createEnvArray(const std::map<std::string, std::string>& env_map);
+  void createEnvArray(const std::map<std::string, std::string>& env_map,
+                      std::vector<std::string>& storage,
+                      std::vector<char*>& envp);
 
   /**
    * Set up a pipe as non-blocking
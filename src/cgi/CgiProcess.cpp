@@ -8,6 +8,7 @@
 
 #include <signal.h>
 #include <sys/signal.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 
 #include <algorithm>
@@ -18,11 +19,29 @@
 #include <ctime>
 #include <sstream>
 
+#include "common/TimerWheel.hpp"
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434  // same number on every architecture
+#endif
+
+/// pidfd_open(2) (Linux >= 5.3, no glibc wrapper before 2.36): a descriptor
+/// that polls readable when the child exits. It is created O_CLOEXEC, later
+/// CGI forks do not inherit it.
+static int openPidFd(pid_t pid) {
+  if (pid <= 0) return -1;
+  long fd = syscall(SYS_pidfd_open, pid, 0);
+  return fd < 0 ? -1 : static_cast<int>(fd);
+}
+
 CgiProcess::CgiProcess(const std::string& script_path,
                        const std::string& interpreter, int pipe_in_write,
                        int pipe_out_read, pid_t pid, int timeout_secs,
                        const std::string& request_body)
     : pid_(pid),
+      pidfd_(openPidFd(pid)),
+      exited_(false),
+      exit_status_(0),
       script_path_(script_path),
       interpreter_(interpreter),
       pipe_in_write_(pipe_in_write),
@@ -32,13 +51,14 @@ CgiProcess::CgiProcess(const std::string& script_path,
       headers_complete_(false),
       status_code_(200),
       state_(RUNNING),
-      start_time_(time(NULL)),
+      start_time_(TimerWheel::nowSec()),
       timeout_secs_(timeout_secs) {}
 
 CgiProcess::~CgiProcess() {
   terminateProcess();
   closePipeIn();
   closePipeOut();
+  closePidFd();
 }
 
 void CgiProcess::terminateProcess() {
@@ -46,12 +66,10 @@ void CgiProcess::terminateProcess() {
     return;
   }
 
-  int status = 0;
-  pid_t ret = waitpid(pid_, &status, WNOHANG);
-
   // Child still running -> terminate and reap.
-  if (ret == 0) {
+  if (!reap()) {
     kill(pid_, SIGKILL);
+    int status = 0;
     while (waitpid(pid_, &status, 0) == -1 && errno == EINTR) {
     }
   }
@@ -59,6 +77,25 @@ void CgiProcess::terminateProcess() {
   pid_ = -1;
 }
 
+bool CgiProcess::reap() {
+  if (exited_ || pid_ <= 0) return exited_;
+
+  int status = 0;
+  if (waitpid(pid_, &status, WNOHANG) == pid_) {
+    exited_ = true;
+    exit_status_ = status;
+  }
+  return exited_;
+}
+
+// WIFEXITED: child ended normally; WEXITSTATUS gives its exit code.
+// WIFSIGNALED: child was terminated by a signal (crash/kill).
+bool CgiProcess::exitedWithError() const {
+  if (!exited_) return false;
+  return (WIFEXITED(exit_status_) && WEXITSTATUS(exit_status_) != 0) ||
+         WIFSIGNALED(exit_status_);
+}
+
 bool CgiProcess::appendResponseData(const char* data, size_t len) {
   complete_response_.append(data, len);
 
@@ -111,7 +148,7 @@ bool CgiProcess::tryParseHeaders() {
 
 bool CgiProcess::isTimedOut() const {
   if (state_ == RUNNING) {
-    time_t now = time(NULL);
+    time_t now = TimerWheel::nowSec();
     return (now - start_time_) >= timeout_secs_;
   }
   return false;
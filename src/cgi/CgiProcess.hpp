@@ -61,6 +61,27 @@ class CgiProcess {
     }
   }
 
+  // pidfd of the child (readable once it exited), -1 if the kernel has no
+  // pidfd_open (< 5.3): the exit status is then polled when stdout closes
+  int getPidFd() const { return pidfd_; }
+  void closePidFd() {
+    if (pidfd_ != -1) {
+      close(pidfd_);
+      pidfd_ = -1;
+    }
+  }
+
+  // ========== Exit Status ==========
+  /**
+   * Non-blocking waitpid() on this child only (never waitpid(-1): other
+   * reactor threads own their own children)
+   * @return true once the child has been reaped
+   */
+  bool reap();
+  bool hasExited() const { return exited_; }
+  int getExitStatus() const { return exit_status_; }
+  bool exitedWithError() const;
+
   // ========== Data Management ==========
   /**
    * Append data read from CGI output
@@ -101,6 +122,9 @@ class CgiProcess {
  private:
   // ========== Process Info ==========
   pid_t pid_;
+  int pidfd_;
+  bool exited_;
+  int exit_status_;  // waitpid() status, valid when exited_
   std::string script_path_;
   std::string interpreter_;
 
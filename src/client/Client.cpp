@@ -9,6 +9,7 @@
 #include "ErrorUtils.hpp"
 #include "RequestProcessorUtils.hpp"
 #include "cgi/CgiProcess.hpp"
+#include "config/ConfigSnapshot.hpp"
 #include "network/ServerManager.hpp"
 
 
@@ -20,35 +21,48 @@
  * and the sent100Continue flag is not set, then enqueue a response with the continue message.
  * The sent100Continue flag is set to true.
  * 
- *
+ * Only called from handleHeadersComplete(), once the request has been
+ * routed and its body is going to be read.
  */
 void Client::handleExpect100() {
   if (_parser.getState() == PARSING_BODY &&
       _parser.getRequest().hasExpect100Continue() && !_sent100Continue) {
-    std::string continueMsg("HTTP/1.1 100 Continue\r\n\r\n");
-    enqueueResponse(std::vector<char>(continueMsg.begin(), continueMsg.end()),
-                    false);
+    enqueueInterim("HTTP/1.1 100 Continue\r\n\r\n");
     _sent100Continue = true;
   }
 }
 
 
 /*
- * @brief Enqueue a response with the continue message.
- * 
- * @param data The data to enqueue.
- * @param closeAfter Whether to close the connection after writing the response.
- * 
+ * @brief Enqueue an interim (1xx) response.
+ *
+ * The request is still being read: _state stays in its read phase (body
+ * timeouts and client_body_min_rate keep applying, drain() does not see an
+ * idle connection) and it does not count as a queued response.
  */
-void Client::enqueueResponse(const std::vector<char>& data, bool closeAfter) {
-  std::string payload(data.begin(), data.end());
-  if (_outBuffer.empty()) {
-    _outBuffer = payload;
-    _closeAfterWrite = closeAfter;
+void Client::enqueueInterim(const std::string& head) {
+  // Nothing goes out after a response that closes the connection
+  if (_closeAfterWrite) return;
+  _output.push(head.data(), head.size());
+}
+
+/*
+ * @brief Enqueue a response without copying its body.
+ *
+ * Only the head is serialized; the body buffer is shared with the
+ * HttpResponse and written right after it (same sendmsg).
+ */
+void Client::enqueueResponse(const HttpResponse& response, bool closeAfter) {
+  if (_closeAfterWrite) return;
+  // A "100 Continue" may still be queued from the read phase
+  if (_output.empty() || _state == STATE_READING_HEADER ||
+      _state == STATE_READING_BODY)
     _state = STATE_WRITING_RESPONSE;
-    return;
-  }
-  _responseQueue.push(PendingResponse(payload, closeAfter));
+  ++_queuedResponses;
+  std::string head = response.serializeHead();
+  _output.push(head.data(), head.size());
+  if (!response.isHeadOnly()) _output.push(response.getBody());
+  _closeAfterWrite = closeAfter;
 }
 
 
@@ -126,6 +140,7 @@ bool Client::handleCompleteRequest() {
     RequestProcessor::ProcessingResult result = _processor.process(
         request, _configs, _listenPort, _parser.getErrorStatusCode());
     _response = result.response;
+    _lingerOnClose = true;  // the rest of the request may still be coming
   } else {
     buildResponse();
     if (_forceCloseCurrentResponse) {
@@ -135,8 +150,7 @@ bool Client::handleCompleteRequest() {
       return true;
     }
   }
-  std::vector<char> serialized = _response.serialize();
-  enqueueResponse(serialized, shouldClose);
+  enqueueResponse(_response, shouldClose);
   return shouldClose;
 }
 
@@ -151,32 +165,43 @@ Client::Client(int fd, const std::vector<ServerConfig>* configs, int listenPort,
       _listenPort(listenPort),
       _clientIp(clientIp),
       _configs(configs),
+      _configSnapshot(0),
       _state(STATE_IDLE),
-      _lastActivity(std::time(0)),
+      _lastActivity(TimerWheel::nowSec()),
       _forceCloseCurrentResponse(false),
-      _outBuffer(),
-      _responseQueue(),
+      _output(),
+      _queuedResponses(0),
+      _pipelineDepth(0),
+      _readSize(MIN_READ_SIZE),
       _parser(),
       _response(),
       _serverManager(0),
       _cgiProcess(0),
-      _cgiServerConfig(0) {
+      _cgiServerConfig(0),
+      _closeAfterWrite(false),
+      _sent100Continue(false),
+      _edgeTriggered(false),
+      _writeBlocked(false),
+      _peerClosed(false),
+      _lingerOnClose(false),
+      _discardBody(false),
+      _idleTimer(),
+      _cgiTimer(),
+      _timeouts(),
+      _phaseStart(_lastActivity),
+      _keepAlive(false),
+      _rateWindowStart(_lastActivity),
+      _rateWindowBytes(0),
+      _lingerStart(0),
+      _lingerBytes(0) {
   const ServerConfig* server = selectServerByPort(listenPort, configs);
   if (server) _parser.setMaxBodySize(server->getGlobalMaxBodySize());
+  _parser.setPauseAtBody(true);  // handleHeadersComplete()
 }
 
 Client::~Client() {
   if (_cgiProcess) {
-    int pipeIn = _cgiProcess->getPipeIn();
-    int pipeOut = _cgiProcess->getPipeOut();
-
-    if (_serverManager) {
-      if (pipeIn >= 0) _serverManager->unregisterCgiPipe(pipeIn);
-      if (pipeOut >= 0) _serverManager->unregisterCgiPipe(pipeOut);
-    }
-
-    _cgiProcess->closePipeIn();
-    _cgiProcess->closePipeOut();
+    detachCgiFds();
     _cgiProcess->terminateProcess();
     delete _cgiProcess;
     _cgiProcess = 0;
@@ -186,20 +211,125 @@ Client::~Client() {
     close(_fd);
     _fd = -1;
   }
+
+  if (_configSnapshot) _configSnapshot->release();
 }
 
 int Client::getFd() const { return _fd; }
 
 ClientState Client::getState() const { return _state; }
 
-bool Client::needsWrite() const { return !_outBuffer.empty(); }
+bool Client::needsWrite() const { return !_output.empty(); }
+
+void Client::tryWrite() {
+  if (!_output.empty() && !_writeBlocked) handleWrite();
+}
 
 bool Client::hasPendingData() const {
-  return _cgiProcess != 0 || !_outBuffer.empty() || !_responseQueue.empty();
+  return _cgiProcess != 0 || !_output.empty();
 }
 
+bool Client::isPeerClosed() const { return _peerClosed; }
+
 time_t Client::getLastActivity() const { return _lastActivity; }
 
+bool Client::hasCgi() const { return _cgiProcess != 0; }
+
+time_t Client::getCgiDeadline() const {
+  if (_cgiProcess == 0) return 0;
+  return _cgiProcess->getStartTime() + _cgiProcess->getTimeoutSeconds();
+}
+
+TimerWheel::Node& Client::getIdleTimer() { return _idleTimer; }
+
+TimerWheel::Node& Client::getCgiTimer() { return _cgiTimer; }
+
+void Client::setTimeouts(const ClientTimeouts& timeouts) {
+  _timeouts = timeouts;
+}
+
+/*
+ * @brief Deadline (seconds) of the phase the connection is in.
+ *
+ * The request head has a fixed budget from its first byte (a client that
+ * trickles one byte at a time cannot extend it); the body, the response
+ * and keep-alive idle time are measured from the last progress.
+ */
+time_t Client::getTimeoutDeadline() const {
+  if (!_output.empty()) return _lastActivity + _timeouts.send;
+
+  switch (_state) {
+    case STATE_READING_HEADER:
+      return _phaseStart + _timeouts.header;
+    case STATE_READING_BODY: {
+      time_t deadline = _lastActivity + _timeouts.body;
+      time_t windowEnd = _rateWindowStart + BODY_RATE_WINDOW;
+      if (_timeouts.bodyMinRate > 0 && windowEnd < deadline) {
+        deadline = windowEnd;  // wake up to check the throughput
+      }
+      return deadline;
+    }
+    case STATE_LINGERING:
+      return _lingerStart + LINGER_SECONDS;
+    default:
+      if (_keepAlive) return _lastActivity + _timeouts.keepalive;
+      return _phaseStart + _timeouts.header;  // nothing received yet
+  }
+}
+
+const char* Client::getTimeoutPhase() const {
+  if (!_output.empty()) return "send";
+  if (_state == STATE_READING_BODY) return "body";
+  if (_state == STATE_LINGERING) return "lingering close";
+  if (_state == STATE_IDLE && _keepAlive) return "keepalive";
+  return "header";
+}
+
+/*
+ * @brief Called when the phase timer fires. Closes the body rate window
+ * if it is over: too few bytes in it times the client out, otherwise a
+ * new window starts.
+ */
+bool Client::checkTimeout(time_t now) {
+  if (_state == STATE_READING_BODY && _output.empty() &&
+      _timeouts.bodyMinRate > 0 &&
+      now >= _rateWindowStart + BODY_RATE_WINDOW) {
+    size_t required = _timeouts.bodyMinRate *
+                      static_cast<size_t>(now - _rateWindowStart);
+    if (_rateWindowBytes < required) return true;
+    _rateWindowStart = now;
+    _rateWindowBytes = 0;
+  }
+  return now > getTimeoutDeadline();
+}
+
+void Client::pinConfig(ConfigSnapshot* snapshot) {
+  if (snapshot) snapshot->acquire();
+  if (_configSnapshot) _configSnapshot->release();
+  _configSnapshot = snapshot;
+}
+
+void Client::setEdgeTriggered(bool edgeTriggered) {
+  _edgeTriggered = edgeTriggered;
+}
+
+void Client::setBufferPool(BufferPool* pool) { _parser.setBufferPool(pool); }
+
+void Client::setBodyBufferSize(size_t bytes) {
+  _parser.setBodyBufferSize(bytes);
+}
+
+void Client::setHeaderLimits(size_t lineSize, size_t headSize,
+                             size_t headerCount) {
+  _parser.setHeaderLimits(lineSize, headSize, headerCount);
+}
+
+void Client::setPipelineDepth(size_t depth) { _pipelineDepth = depth; }
+
+bool Client::isReadPaused() const {
+  return _pipelineDepth > 0 && _queuedResponses >= _pipelineDepth;
+}
+
 // =============================================================================
 // MANEJO DE EVENTOS (llamados desde el bucle epoll)
 // =============================================================================
@@ -212,28 +342,69 @@ time_t Client::getLastActivity() const { return _lastActivity; }
  * Process requests.
  * If the parser is in the ERROR state, handle the complete request.
  * 
+ * Level triggered: one recv() per event, epoll reports again if more data
+ * is waiting. Edge triggered: drain the socket until EAGAIN, no new edge
+ * would come for bytes left behind.
+ * 
+ * recv() == 0 is a half-close: responses already queued (or a running CGI)
+ * are still delivered before the connection is closed.
+ *
+ * recv() writes straight into the parser's buffer (pooled, no copy through
+ * a stack array). The size offered grows x2 while reads fill it, up to
+ * MAX_READ_SIZE; once everything received has been parsed the buffer goes
+ * back to the pool, an idle keep-alive connection holds none.
  */
 void Client::handleRead() {
-  char buffer[4096];
-  ssize_t bytesRead = 0;
-
-  bytesRead = recv(_fd, buffer, sizeof(buffer), 0);
-  if (bytesRead > 0) {
-    _lastActivity = std::time(0);
-    if (_state == STATE_IDLE) _state = STATE_READING_HEADER;
-
-    _parser.consume(std::string(buffer, bytesRead));
-    handleExpect100();
-    processRequests();
+  if (_state == STATE_LINGERING || _discardBody) {
+    discardInput();
+    return;
+  }
+  while (true) {
+    if (isReadPaused()) return;  // resumePipeline() picks it up again
+    size_t room = 0;
+    char* dst = _parser.prepareRead(_readSize, room);
+    ssize_t bytesRead = recv(_fd, dst, room, 0);
+    if (bytesRead > 0) {
+      _lastActivity = TimerWheel::nowSec();
+      if (_state == STATE_IDLE) {
+        _state = STATE_READING_HEADER;
+        _phaseStart = _lastActivity;
+      } else if (_state == STATE_READING_BODY) {
+        _rateWindowBytes += static_cast<size_t>(bytesRead);
+      }
+      if (static_cast<size_t>(bytesRead) == room && _readSize < MAX_READ_SIZE)
+        _readSize *= 2;
+
+      _parser.commitRead(static_cast<size_t>(bytesRead));
+      handleHeadersComplete();
+      if (_state == STATE_READING_HEADER &&
+          _parser.getState() == PARSING_BODY) {
+        _state = STATE_READING_BODY;
+        _rateWindowStart = _lastActivity;
+        _rateWindowBytes = 0;
+      }
+      processRequests();
+
+      if (_parser.getState() == ERROR) {
+        handleCompleteRequest();
+        return;
+      }
+      if (_parser.bufferedBytes() == 0) {
+        _parser.releaseIdleBuffer();
+        if (_parser.getState() == PARSING_START_LINE) _readSize = MIN_READ_SIZE;
+      }
+      if (!_edgeTriggered) return;
+      continue;
+    }
 
-    if (_parser.getState() == ERROR) {
-      handleCompleteRequest();
-      return;
+    if (bytesRead == 0) {
+      _peerClosed = true;
+      if (!hasPendingData()) _state = STATE_CLOSED;
+    } else if (!_edgeTriggered || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+      _state = STATE_CLOSED;
     }
-  } else if (bytesRead == 0) {
-    _state = STATE_CLOSED;
-  } else {
-    _state = STATE_CLOSED;
+    _parser.releaseIdleBuffer();
+    return;
   }
 }
 
@@ -242,11 +413,16 @@ void Client::handleRead() {
  * 
  * Process requests until the parser is not in the COMPLETE state.
  * If the parser is in the COMPLETE state, handle the complete request.
- * 
+ *
+ * Every complete request in the receive buffer is answered in one go; the
+ * responses pile up in _output and leave together in the next flush. Up to
+ * pipeline_depth of them: then the remaining requests stay parked in the
+ * buffer (and the socket is not read) until handleWrite() drains the queue.
  */
 void Client::processRequests() {
   while (_parser.getState() == COMPLETE) {
     if (_cgiProcess) return;
+    if (isReadPaused()) return;
     bool shouldClose = handleCompleteRequest();
     if (_cgiProcess) {
       _response.clear();
@@ -259,7 +435,54 @@ void Client::processRequests() {
     _parser.reset();
     _sent100Continue = false;
     _parser.consume("");
+    handleHeadersComplete();
+  }
+}
+
+/*
+ * @brief Route a request whose head just completed, before its body.
+ *
+ * The parser stops between the head and the body (setPauseAtBody).
+ *
+ * The matched location's max_body_size becomes the parser's limit for this
+ * body: a Content-Length above it fails right here with 413 and a chunked
+ * body fails as soon as it goes over, nothing beyond the limit is stored.
+ * The 413 closes the connection, so the rest of the body is never parsed
+ * (only discarded for a while by the lingering close, see startLingering).
+ *
+ * With Expect: 100-continue the client waits for us before sending the
+ * body, so a request whose answer does not depend on it (404, 301/302,
+ * 405, or the 413 above) gets that final response instead of the
+ * "100 Continue" and the connection closes after it, lingering too: the
+ * client may send the body anyway: from then on handleRead() throws away
+ * whatever arrives (discardInput) without going through the parser, the
+ * request is not planned again. If the whole body is already in the
+ * buffer it is simply read, process() answers the same and the connection
+ * can stay open. Without Expect the body is already on its way and is read
+ * as usual.
+ *
+ * A POST that will end up in upload_store gets its body written straight
+ * into a temp file there (preallocated to Content-Length) as it arrives;
+ * the upload handler only renames it. Anything else keeps the usual storage.
+ */
+void Client::handleHeadersComplete() {
+  if (!_parser.isAtBodyStart()) return;
+
+  const HttpRequest& request = _parser.getRequest();
+  RequestProcessor::BodyPlan plan =
+      _processor.planBody(request, _configs, _listenPort);
+  if (!_parser.limitBody(plan.maxBodySize)) return;
+  if (plan.rejectStatus != 0 && request.hasExpect100Continue() &&
+      !_parser.isBodyBuffered()) {
+    buildResponse();  // process() answers from the head alone
+    _lingerOnClose = true;
+    _discardBody = true;  // the body, if sent anyway, is never parsed
+    enqueueResponse(_response, true);
+    return;
   }
+  if (!plan.uploadStore.empty()) _parser.storeBodyIn(plan.uploadStore);
+  _parser.startBody();
+  handleExpect100();
 }
 
 // ============================
@@ -267,38 +490,141 @@ void Client::processRequests() {
 // ============================
 
 /*
- * @brief Handle a write event.
- * 
- * Send data to the socket.
- * If the out buffer is empty, return.
- * If the out buffer is not empty, send the data to the socket.
- * 
+ * @brief Continue after the output queue drained.
+ *
+ * If the pipeline was full, processRequests() stopped with requests still
+ * in the receive buffer and reading was paused. Answer them now; with
+ * edge-triggered events no new EPOLLIN edge would come for the bytes
+ * still in the socket, so read them here too (level triggered re-arms
+ * EPOLLIN in ServerManager::updateClientEvents).
  */
-void Client::handleWrite() {
-  if (_outBuffer.empty()) return;
+void Client::resumePipeline() {
+  bool wasPaused = isReadPaused();
+  _queuedResponses = 0;
+  if (!wasPaused) return;
 
-  ssize_t bytesSent = send(_fd, _outBuffer.c_str(), _outBuffer.size(), 0);
-  if (bytesSent > 0) {
-    _lastActivity = std::time(0);
-    _outBuffer.erase(0, bytesSent);
-  } else if (bytesSent < 0) {
+  processRequests();
+  if (_parser.getState() == ERROR) {
+    handleCompleteRequest();
+    return;
+  }
+  if (_edgeTriggered && !_peerClosed) handleRead();
+}
+
+/*
+ * @brief Lingering close, after a response that closes the connection
+ * while the client may still be sending its request (413, an error in the
+ * middle of the body, an Expect request rejected before its body).
+ *
+ * close() with unread data in the socket makes the kernel send RST, and
+ * the RST can wipe the response from the client's receive buffer before
+ * it reads it. Instead: shutdown(SHUT_WR) (the client sees the end of the
+ * response) and keep reading and throwing away what it sends until it
+ * closes, for at most LINGER_SECONDS and LINGER_MAX_BYTES.
+ */
+void Client::startLingering() {
+  _state = STATE_LINGERING;
+  _lingerStart = TimerWheel::nowSec();
+  _queuedResponses = 0;  // nothing will be answered: never pause reading
+  if (shutdown(_fd, SHUT_WR) != 0) {
     _state = STATE_CLOSED;
     return;
   }
+  discardInput();  // edge triggered: bytes already waiting bring no edge
+}
 
-  if (_outBuffer.empty()) {
-    if (_closeAfterWrite == true) {
+/*
+ * @brief Read and throw away the rest of a request that will not be
+ * processed: while lingering, and before that, while the response to a
+ * rejected Expect request is still being sent (_discardBody).
+ *
+ * _lingerBytes counts from the first discarded byte, both phases share
+ * LINGER_MAX_BYTES. End of stream while lingering means the response got
+ * through; before that it is a half-close like in handleRead().
+ */
+void Client::discardInput() {
+  char discard[16384];  // se tira: no hace falta el buffer del parser
+
+  while (true) {
+    ssize_t bytesRead = recv(_fd, discard, sizeof(discard), 0);
+    if (bytesRead > 0) {
+      _lingerBytes += static_cast<size_t>(bytesRead);
+      if (_lingerBytes > LINGER_MAX_BYTES) {
+        _state = STATE_CLOSED;
+        return;
+      }
+      if (!_edgeTriggered) return;
+      continue;
+    }
+    if (bytesRead == 0) {
+      _peerClosed = true;
+      if (_state == STATE_LINGERING || !hasPendingData())
+        _state = STATE_CLOSED;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      _state = STATE_CLOSED;
+    }
+    return;
+  }
+}
+
+/*
+ * @brief Handle a write event.
+ *
+ * Flushes the output queue: every queued response (pipelined ones
+ * included) is gathered into one sendmsg(), a partial send only advances
+ * the queue offset.
+ *
+ * Level triggered: one flush per EPOLLOUT. Edge triggered: keep flushing
+ * until everything is out or the socket returns EAGAIN.
+ *
+ * Called on EPOLLOUT and, inline, right after responses are queued
+ * (tryWrite). EAGAIN or a send that did not take everything marks the
+ * socket as full: no more inline attempts until the next EPOLLOUT.
+ *
+ * Once the queue is empty, requests parked by pipeline_depth are processed
+ * (resumePipeline); their responses are flushed in the same way.
+ */
+void Client::handleWrite() {
+  _writeBlocked = false;
+  if (_output.empty()) return;
+
+  while (!_output.empty()) {
+    ssize_t bytesSent = _output.flush(_fd);
+    if (bytesSent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        _writeBlocked = true;
+        return;
+      }
       _state = STATE_CLOSED;
       return;
     }
-    if (_responseQueue.empty() == false) {
-      PendingResponse next = _responseQueue.front();
-      _responseQueue.pop();
-      _outBuffer = next.data;
-      _closeAfterWrite = next.closeAfter;
-      _state = STATE_WRITING_RESPONSE;
+
+    _lastActivity = TimerWheel::nowSec();
+    if (!_output.empty()) {
+      if (_edgeTriggered) continue;  // until EAGAIN
+      _writeBlocked = true;
       return;
     }
-    _state = STATE_IDLE;
+    if (!_closeAfterWrite) resumePipeline();
+    if (_state == STATE_CLOSED) return;
+    if (!_output.empty() && !_edgeTriggered) return;  // tryWrite() sends it
+  }
+
+  if (_closeAfterWrite == true) {
+    if (_lingerOnClose && !_peerClosed) {
+      startLingering();
+    } else {
+      _state = STATE_CLOSED;
+    }
+    return;
+  }
+  // Everything delivered: a half-closed peer has nothing more to send us
+  if (_peerClosed && _cgiProcess == 0) {
+    _state = STATE_CLOSED;
+    return;
   }
+  // Only an interim 1xx went out: the request is still being read
+  if (_state == STATE_READING_HEADER || _state == STATE_READING_BODY) return;
+  _state = STATE_IDLE;
+  _keepAlive = true;
 }
@@ -2,31 +2,40 @@
 #define CLIENT_HPP
 
 #include <ctime>
-#include <queue>
 #include <string>
 #include <vector>
 
+#include "OutputQueue.hpp"
 #include "RequestProcessor.hpp"
+#include "common/TimerWheel.hpp"
 #include "config/ServerConfig.hpp"
 #include "http/HttpParser.hpp"
 #include "http/HttpRequest.hpp"
 #include "http/HttpResponse.hpp"
 
 class ServerManager;
+class BufferPool;
 class CgiProcess;
+class ConfigSnapshot;
 
 enum ClientState {
   STATE_IDLE,            // Sin petición activa
   STATE_READING_HEADER,  // Leyendo headers del cliente
   STATE_READING_BODY,    // Leyendo body (POST, etc.)
   STATE_WRITING_RESPONSE,
+  STATE_LINGERING,  // Respuesta de cierre enviada: se descarta lo que llegue
   STATE_CLOSED
 };
 
-struct PendingResponse {
-  std::string data;
-  bool closeAfter;
-  PendingResponse(const std::string& d, bool c) : data(d), closeAfter(c) {}
+// Per-phase limits in seconds (GlobalConfig, resolved by ServerManager)
+struct ClientTimeouts {
+  int header;          // accept/first byte -> end of headers, never extended
+  int body;            // between two reads of the body
+  int keepalive;       // idle between two requests
+  int send;            // between two writes that made progress
+  size_t bodyMinRate;  // bytes/s per BODY_RATE_WINDOW, 0 = off
+  ClientTimeouts()
+      : header(60), body(60), keepalive(60), send(60), bodyMinRate(0) {}
 };
 
 // -----------------------------------------------------------------------------
@@ -45,11 +54,42 @@ class Client {
   int getFd() const;
   ClientState getState() const;
   bool needsWrite() const;
+  // Inline write: flush queued output now unless the last send hit EAGAIN
+  // (then EPOLLOUT calls handleWrite())
+  void tryWrite();
   bool hasPendingData() const;
+  bool isPeerClosed() const;
   time_t getLastActivity() const;
+  bool hasCgi() const;
+  time_t getCgiDeadline() const;
+
+  // ---- Timeouts por fase (slowloris) ----
+  void setTimeouts(const ClientTimeouts& timeouts);
+  time_t getTimeoutDeadline() const;  // of the current phase
+  const char* getTimeoutPhase() const;
+  // true if the current phase ran out of time (or the body is too slow)
+  bool checkTimeout(time_t now);
+
+  // ---- Timers (nodos intrusivos, armados por ServerManager) ----
+  TimerWheel::Node& getIdleTimer();
+  TimerWheel::Node& getCgiTimer();
 
   // ---- Manejo de eventos (llamados desde ServerManager/epoll) ----
   void setServerManager(ServerManager* serverManager);
+  // Keeps `snapshot` (the configs passed to the constructor) alive for the
+  // lifetime of the connection, across configuration reloads
+  void pinConfig(ConfigSnapshot* snapshot);
+  void setEdgeTriggered(bool edgeTriggered);
+  // Receive buffers come from (and go back to) the reactor's pool
+  void setBufferPool(BufferPool* pool);
+  // client_body_buffer_size: larger request bodies are spooled to a temp file
+  void setBodyBufferSize(size_t bytes);
+  // large_client_header_buffers / client_max_header_count (414 / 431)
+  void setHeaderLimits(size_t lineSize, size_t headSize, size_t headerCount);
+  // pipeline_depth: unsent responses after which reading stops
+  void setPipelineDepth(size_t depth);
+  // Pipeline full: no recv() until handleWrite() drains the output
+  bool isReadPaused() const;
   void handleRead();
   void handleWrite();
   void handleCgiPipe(int pipe_fd, size_t events);
@@ -59,6 +99,16 @@ class Client {
   void buildResponse();
 
  private:
+  // recv() size: starts small, doubles while reads fill it (uploads)
+  static const size_t MIN_READ_SIZE = 4096;
+  static const size_t MAX_READ_SIZE = 65536;
+  // client_body_min_rate is measured over windows of this many seconds
+  static const int BODY_RATE_WINDOW = 5;
+  // Lingering close: como mucho este tiempo/bytes descartando el body que
+  // el cliente siga enviando tras una respuesta que cierra
+  static const int LINGER_SECONDS = 5;
+  static const size_t LINGER_MAX_BYTES = 16 * 1024 * 1024;
+
   Client(const Client&);
   Client& operator=(const Client&);
 
@@ -67,13 +117,16 @@ class Client {
   int _listenPort;
   std::string _clientIp;
   const std::vector<ServerConfig>* _configs;
+  ConfigSnapshot* _configSnapshot;  // owner of *_configs, may be NULL
   ClientState _state;
   time_t _lastActivity;
   bool _forceCloseCurrentResponse;
 
   // ---- Buffers ----
-  std::string _outBuffer;  // Respuesta lista para enviar
-  std::queue<PendingResponse> _responseQueue;
+  OutputQueue _output;  // Respuestas listas para enviar (en orden)
+  size_t _queuedResponses;  // encoladas desde que _output quedó vacío
+  size_t _pipelineDepth;    // límite de _queuedResponses (pipeline_depth)
+  size_t _readSize;     // espacio pedido al buffer del parser por recv()
 
   // ---- Parser y respuesta HTTP ----
   HttpParser _parser;
@@ -88,17 +141,42 @@ class Client {
   // ---- Flags ----
   bool _closeAfterWrite;
   bool _sent100Continue;  // Para Expect: 100-continue
+  bool _edgeTriggered;    // EPOLLET: leer/escribir hasta EAGAIN
+  bool _writeBlocked;     // el último send() no cupo: esperar a EPOLLOUT
+  bool _peerClosed;       // recv() == 0: el cliente cerro su lado de escritura
+  bool _lingerOnClose;    // el cierre deja body sin leer: lingering close
+  bool _discardBody;      // Expect rechazado: el body que llegue se tira
+
+  // ---- Timers ----
+  TimerWheel::Node _idleTimer;  // timeout de la fase actual
+  TimerWheel::Node _cgiTimer;   // CGI en ejecucion
+  ClientTimeouts _timeouts;
+  time_t _phaseStart;       // accept, or first byte of the request head
+  bool _keepAlive;          // a response was delivered: idle = keepalive
+  time_t _rateWindowStart;  // client_body_min_rate accounting
+  size_t _rateWindowBytes;
+  time_t _lingerStart;  // shutdown(SHUT_WR) de STATE_LINGERING
+  size_t _lingerBytes;  // descartados (Expect rechazado + lingering)
 
   // ---- Funciones auxiliares (solo usadas dentro de la clase) ----
   bool
   handleCompleteRequest();  // Request parseada → construir y encolar respuesta
-  void enqueueResponse(const std::vector<char>& data, bool closeAfter);
+  void enqueueInterim(const std::string& head);  // 1xx, keeps _state
+  void enqueueResponse(const HttpResponse& response, bool closeAfter);
   void handleExpect100();  // Expect: 100-continue
+  void handleHeadersComplete();  // head parsed, body not read yet
+  void resumePipeline();         // output drained: parked requests
+  void startLingering();         // closing response sent, body still coming
+  void discardInput();           // recv() and throw away, no parser
   bool startCgiIfNeeded(const HttpRequest& request);
   void finalizeCgiResponse();
 
   // Invocado cuando el parser marca una HttpRequest como completa.
   void finalizeCgiResponse(const CgiProcess* finishedProcess);
+  // Saca del event loop y cierra los pipes y el pidfd del CGI
+  void detachCgiFds();
+  // Output drained (and child reaped when there is a pidfd): build response
+  void finishCgi();
   void processRequests();
   //
   // Invocado cuando el parser marca una HttpRequest como completa.
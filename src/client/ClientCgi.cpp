@@ -75,6 +75,8 @@ bool Client::executeCgi(const RequestProcessor::CgiInfo& cgiInfo) {
                                   EPOLLIN | EPOLLRDHUP, this);
   _serverManager->registerCgiPipe(_cgiProcess->getPipeIn(),
                                   EPOLLOUT | EPOLLRDHUP, this);
+  // Exit of the child as an event: no waitpid() polling in the loop
+  _serverManager->registerCgiPipe(_cgiProcess->getPidFd(), EPOLLIN, this);
 
   _state = STATE_READING_BODY;
 
@@ -116,25 +118,17 @@ void Client::finalizeCgiResponse(const CgiProcess* finishedProcess) {
     return;
   }
 
-  int child_status = 0;
-  bool has_child_status = false;
-  if (_serverManager != 0) {
-    has_child_status = _serverManager->consumeCgiExitStatus(
-        finishedProcess->getPid(), child_status);
-  }
+  // The idle timer was suspended while the CGI ran: restart it from now
+  _lastActivity = TimerWheel::nowSec();
 
-  // WIFEXITED: child ended normally; WEXITSTATUS gives its exit code.
-  // WIFSIGNALED: child was terminated by a signal (crash/kill).
-  if (has_child_status) {
-    if ((WIFEXITED(child_status) && WEXITSTATUS(child_status) != 0) ||
-        WIFSIGNALED(child_status)) {
-      _response.clear();
-      buildErrorResponse(_response, _parser.getRequest(), 500, true, _cgiServerConfig);
+  // A child still running here (no pidfd) is treated as a success
+  if (finishedProcess->exitedWithError()) {
+    _response.clear();
+    buildErrorResponse(_response, _parser.getRequest(), 500, true, _cgiServerConfig);
 
-      enqueueResponse(_response.serialize(), true);
-      processRequests();
-      return;
-    }
+    enqueueResponse(_response, true);
+    processRequests();
+    return;
   }
 
   _response.setStatusCode(finishedProcess->getStatusCode());
@@ -142,25 +136,46 @@ void Client::finalizeCgiResponse(const CgiProcess* finishedProcess) {
     _response.setVersion("HTTP/1.0");
   else
     _response.setVersion("HTTP/1.1");
-  _response.setHeader("Connection", _savedShouldClose ? "close" : "keep-alive");
+  _response.setHeader(HTTP_HEADER_CONNECTION, _savedShouldClose ? "close" : "keep-alive");
 
   if (finishedProcess->isHeadersComplete()) {
     parseCgiHeaders(finishedProcess->getResponseHeaders(), _response);
     _response.setBody(finishedProcess->getResponseBody());
   } else {
-    if (!_response.hasHeader("Content-Type")) {
-      _response.setHeader("Content-Type", "text/plain");
+    if (!_response.hasHeader(HTTP_HEADER_CONTENT_TYPE)) {
+      _response.setHeader(HTTP_HEADER_CONTENT_TYPE, "text/plain");
     }
     _response.setBody(finishedProcess->getCompleteResponse());
   }
 
-  std::vector<char> serialized = _response.serialize();
-  enqueueResponse(serialized, _savedShouldClose);
+  enqueueResponse(_response, _savedShouldClose);
 
   // Resume processing requests (in case pipelined data is waiting)
   processRequests();
 }
 
+void Client::detachCgiFds() {
+  int fds[3] = {_cgiProcess->getPipeIn(), _cgiProcess->getPipeOut(),
+                _cgiProcess->getPidFd()};
+
+  if (_serverManager) {
+    for (int i = 0; i < 3; ++i) {
+      if (fds[i] >= 0) _serverManager->unregisterCgiPipe(fds[i]);
+    }
+  }
+  _cgiProcess->closePipeIn();
+  _cgiProcess->closePipeOut();
+  _cgiProcess->closePidFd();
+}
+
+void Client::finishCgi() {
+  CgiProcess* finished = _cgiProcess;
+  detachCgiFds();
+  _cgiProcess = 0;
+  finalizeCgiResponse(finished);
+  delete finished;
+}
+
 void Client::handleCgiPipe(int pipe_fd, size_t events) {
   if (_cgiProcess == 0) {
     if (_serverManager) {
@@ -169,6 +184,19 @@ void Client::handleCgiPipe(int pipe_fd, size_t events) {
     return;
   }
 
+  if (pipe_fd == _cgiProcess->getPidFd()) {
+    // The child exited. Its stdout was closed before the pidfd became
+    // readable, so EOF is already waiting unless a grandchild kept the pipe
+    // open; a failed script does not need the rest of its output.
+    _serverManager->unregisterCgiPipe(pipe_fd);
+    _cgiProcess->closePidFd();
+    _cgiProcess->reap();
+    if (_cgiProcess->getPipeOut() < 0 || _cgiProcess->exitedWithError()) {
+      finishCgi();
+    }
+    return;
+  }
+
   if (pipe_fd == _cgiProcess->getPipeIn()) {
     if (events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
       _serverManager->unregisterCgiPipe(pipe_fd);
@@ -187,7 +215,7 @@ void Client::handleCgiPipe(int pipe_fd, size_t events) {
           write(pipe_fd, body.c_str() + offset, body.size() - offset);
       if (written > 0) {
         _cgiProcess->advanceBodyBytesWritten(static_cast<size_t>(written));
-        _lastActivity = std::time(0);
+        _lastActivity = TimerWheel::nowSec();
       } else if (written < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
           return;
@@ -215,22 +243,20 @@ void Client::handleCgiPipe(int pipe_fd, size_t events) {
     ssize_t bytes = read(pipe_fd, buffer, sizeof(buffer));
     if (bytes > 0) {
       _cgiProcess->appendResponseData(buffer, static_cast<size_t>(bytes));
-      _lastActivity = std::time(0);
+      _lastActivity = TimerWheel::nowSec();
       return;
     }
     if (bytes == 0) {
-      // EOF - Pipe closed by CGI process
-      CgiProcess* finished = _cgiProcess;
+      // EOF - Pipe closed by CGI process. The response waits for the exit
+      // event when the child is still running, so its status is known.
       _serverManager->unregisterCgiPipe(pipe_fd);
-      int pipeIn = finished->getPipeIn();
+      _cgiProcess->closePipeOut();
+      int pipeIn = _cgiProcess->getPipeIn();
       if (pipeIn >= 0) {
         _serverManager->unregisterCgiPipe(pipeIn);
-        finished->closePipeIn();
+        _cgiProcess->closePipeIn();
       }
-      finished->closePipeOut();
-      _cgiProcess = 0;
-      finalizeCgiResponse(finished);
-      delete finished;
+      if (_cgiProcess->getPidFd() < 0 || _cgiProcess->reap()) finishCgi();
       return;
     }
     if (bytes < 0) {
@@ -241,20 +267,14 @@ void Client::handleCgiPipe(int pipe_fd, size_t events) {
       }
       // Real pipe read error — CGI output is unreliable.
       // Build a clean 502 Bad Gateway instead of forwarding partial data.
-      _serverManager->unregisterCgiPipe(pipe_fd);
-      int pipeIn = _cgiProcess->getPipeIn();
-      if (pipeIn >= 0) {
-        _serverManager->unregisterCgiPipe(pipeIn);
-        _cgiProcess->closePipeIn();
-      }
-      _cgiProcess->closePipeOut();
+      detachCgiFds();
       _cgiProcess->terminateProcess();
       delete _cgiProcess;
       _cgiProcess = 0;
 
       _response.clear();
       buildErrorResponse(_response, _parser.getRequest(), 502, true, _cgiServerConfig);
-      enqueueResponse(_response.serialize(), true);
+      enqueueResponse(_response, true);
       return;
     }
   }
@@ -269,20 +289,7 @@ bool Client::checkCgiTimeout() {
     return false;
   }
 
-  int pipeIn = _cgiProcess->getPipeIn();
-  int pipeOut = _cgiProcess->getPipeOut();
-
-  if (_serverManager) {
-    if (pipeIn >= 0) {
-      _serverManager->unregisterCgiPipe(pipeIn);
-    }
-    if (pipeOut >= 0) {
-      _serverManager->unregisterCgiPipe(pipeOut);
-    }
-  }
-
-  _cgiProcess->closePipeIn();
-  _cgiProcess->closePipeOut();
+  detachCgiFds();
   _cgiProcess->terminateProcess();
   delete _cgiProcess;
   _cgiProcess = 0;
@@ -290,7 +297,7 @@ bool Client::checkCgiTimeout() {
   _response.clear();
   buildErrorResponse(_response, _parser.getRequest(), 504, true, _cgiServerConfig);
 
-  enqueueResponse(_response.serialize(), true);
-  _lastActivity = std::time(0);
+  enqueueResponse(_response, true);
+  _lastActivity = TimerWheel::nowSec();
   return true;
 }
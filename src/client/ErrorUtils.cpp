@@ -1,26 +1,10 @@
 #include "ErrorUtils.hpp"
 
-#include <fstream>
 #include <sstream>
 
 #include "RequestProcessorUtils.hpp"
 #include "ResponseUtils.hpp"
 
-/*
- * @brief Read a file to a body.
- * 
- * Read a file to a body.
- * return true if the file is read successfully, false otherwise.
- */
-static bool readFileToBody(const std::string& path, std::vector<char>& out) {
-  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
-  if (!file.is_open()) return false;
-  out.clear();
-  char c;
-  while (file.get(c)) out.push_back(c);
-  return true;
-}
-
 /*
  * @brief Build an error response.
  * 
@@ -57,7 +41,7 @@ void buildErrorResponse(HttpResponse& response, const HttpRequest& request,
        << "<h1>Error " << statusCode << "</h1>"
        << "<p>Ocurrió un error en el servidor LaserWeb.</p>"
        << "</body></html>";
-  fillBaseResponse(response, request, statusCode, shouldClose,
-                   toBody(html.str()));
-  response.setHeader("Content-Type", "text/html");
+  body = toBody(html.str());
+  fillBaseResponse(response, request, statusCode, shouldClose, body);
+  response.setHeader(HTTP_HEADER_CONTENT_TYPE, "text/html");
 }
@@ -0,0 +1,71 @@
+#include "OutputQueue.hpp"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstring>
+
+OutputQueue::OutputQueue() : chain_(), offset_(0), size_(0) {}
+
+OutputQueue::~OutputQueue() {}
+
+void OutputQueue::push(const char* data, size_t len) {
+  if (len == 0) return;
+  chain_.push_back(SharedBuffer());
+  chain_.back().assign(data, len);
+  size_ += len;
+}
+
+void OutputQueue::push(const SharedBuffer& buffer) {
+  if (buffer.empty()) return;
+  chain_.push_back(buffer);
+  size_ += buffer.size();
+}
+
+// More buffers than fit in one call: MSG_MORE keeps the last segment of this
+// batch open so it is merged with the first bytes of the next one.
+ssize_t OutputQueue::flush(int fd) {
+  struct iovec iov[MAX_IOV];
+  size_t count = 0;
+
+  for (std::deque<SharedBuffer>::iterator it = chain_.begin();
+       it != chain_.end() && count < MAX_IOV; ++it, ++count) {
+    size_t skip = (count == 0) ? offset_ : 0;
+    iov[count].iov_base = const_cast<char*>(it->data() + skip);
+    iov[count].iov_len = it->size() - skip;
+  }
+
+  struct msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = count;
+
+  int flags = (count < chain_.size()) ? MSG_MORE : 0;
+  ssize_t sent = sendmsg(fd, &msg, flags);
+  if (sent > 0) consume(static_cast<size_t>(sent));
+  return sent;
+}
+
+void OutputQueue::consume(size_t bytes) {
+  size_ -= bytes;
+  while (bytes > 0) {
+    size_t left = chain_.front().size() - offset_;
+    if (bytes < left) {
+      offset_ += bytes;
+      return;
+    }
+    bytes -= left;
+    chain_.pop_front();
+    offset_ = 0;
+  }
+}
+
+bool OutputQueue::empty() const { return size_ == 0; }
+
+size_t OutputQueue::size() const { return size_; }
+
+void OutputQueue::clear() {
+  chain_.clear();
+  offset_ = 0;
+  size_ = 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <deque>
+
+#include "common/SharedBuffer.hpp"
+
+/**
+ * @brief Bytes waiting to be written to a client socket.
+ *
+ * A chain of buffers (a response is its serialized head plus its body)
+ * plus the offset already sent from the first one:
+ *
+ * - push(SharedBuffer): O(1), the body is shared with the HttpResponse,
+ *   not copied. push(data, len) copies (small buffers: heads, 100-continue).
+ * - flush: one sendmsg() gathers up to MAX_IOV buffers, so pipelined
+ *   responses leave in the same syscall (and the same segments).
+ * - a partial send only moves the offset: no erase(0, n) of the remaining
+ *   bytes, which made multi-MB bodies quadratic.
+ */
+class OutputQueue {
+ public:
+  // Buffers gathered per sendmsg() (IOV_MAX is 1024 on Linux)
+  static const size_t MAX_IOV = 64;
+
+  OutputQueue();
+  ~OutputQueue();
+
+  void push(const char* data, size_t len);
+  void push(const SharedBuffer& buffer);
+
+  // Sends as much as the socket takes in one call. Returns the bytes sent,
+  // or -1 with errno set (EAGAIN included).
+  ssize_t flush(int fd);
+
+  bool empty() const;
+  size_t size() const;  // bytes not sent yet
+  void clear();
+
+ private:
+  std::deque<SharedBuffer> chain_;
+  size_t offset_;  // bytes of chain_.front() already sent
+  size_t size_;
+
+  void consume(size_t bytes);
+
+  // Disable copying
+  OutputQueue(const OutputQueue&);
+  OutputQueue& operator=(const OutputQueue&);
+};
@@ -40,7 +40,7 @@ bool RequestProcessor::handleLocationValidation(
     body.clear();
     fillBaseResponse(result.response, request, validationCode, shouldClose,
                      body);
-    result.response.setHeader("Location", location->getRedirectUrl());
+    result.response.setHeader(HTTP_HEADER_LOCATION, location->getRedirectUrl());
   } else {
     buildErrorResponse(result.response, request, validationCode, true, server);
   }
@@ -102,6 +102,37 @@ bool RequestProcessor::handleCgi(const HttpRequest& request,
   return true;
 }
 
+RequestProcessor::BodyPlan RequestProcessor::planBody(
+    const HttpRequest& request, const std::vector<ServerConfig>* configs,
+    int listenPort) const {
+  BodyPlan plan;
+  const ServerConfig* server = selectServerByPort(listenPort, configs);
+  if (!server) return plan;
+  const LocationConfig* location = matchLocation(*server, request.getPath());
+  // Igual que validateLocation(): el de la location manda sobre el del server
+  plan.maxBodySize =
+      location ? location->getMaxBodySize() : server->getMaxBodySize();
+
+  // Respuestas de process() que no dependen del body (el body aún está
+  // vacío, validateLocation() solo puede dar redirección o 405)
+  if (!location) {
+    plan.rejectStatus = HTTP_STATUS_NOT_FOUND;
+    return plan;
+  }
+  plan.rejectStatus = validateLocation(request, server, location);
+  if (plan.rejectStatus != 0) return plan;
+
+  if (request.getMethod() != HTTP_METHOD_POST) return plan;
+  if (location->getUploadStore().empty()) return plan;
+
+  std::string resolvedPath = resolvePath(*server, location, request.getPath());
+  if (isCgiRequest(resolvedPath) ||
+      isCgiRequestByConfig(location, resolvedPath))
+    return plan;
+  plan.uploadStore = location->getUploadStore();
+  return plan;
+}
+
 RequestProcessor::ProcessingResult RequestProcessor::process(
     const HttpRequest& request, const std::vector<ServerConfig>* configs,
     int listenPort, int parseErrorCode) {
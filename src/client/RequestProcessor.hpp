@@ -32,6 +32,24 @@ class RequestProcessor {
                            const std::vector<ServerConfig>* configs,
                            int listenPort, int parseErrorCode);
 
+  // What to do with a body before reading it (only the head is parsed).
+  struct BodyPlan {
+    BodyPlan() : maxBodySize(0), rejectStatus(0) {}
+    // upload_store the body will be saved in by process(), "" if it is not
+    // an upload (CGI, error, redirect...)
+    std::string uploadStore;
+    // max_body_size of the matched location (server's if none), 0 = none
+    std::size_t maxBodySize;
+    // Final status process() will give whatever the body (404 no location,
+    // 301/302 redirect, 405 method), 0 if the body is wanted
+    int rejectStatus;
+  };
+
+  // Same routing as process()
+  BodyPlan planBody(const HttpRequest& request,
+                    const std::vector<ServerConfig>* configs,
+                    int listenPort) const;
+
  private:
   bool handleParseOrMethodErrors(const HttpRequest& request,
                                  int parseErrorCode,
@@ -1,5 +1,9 @@
 #include "ResponseUtils.hpp"
 
+#include <sys/stat.h>
+
+#include <fstream>
+
 #include "SessionUtils.hpp"
 
 static std::string versionToString(HttpVersion version) {
@@ -11,10 +15,36 @@ std::vector<char> toBody(const std::string& text) {
   return std::vector<char>(text.begin(), text.end());
 }
 
+/*
+ * @brief Read a file to a body.
+ *
+ * The buffer is sized once from the file length and filled with one
+ * read(), instead of growing it one byte at a time.
+ * return true if the file is read successfully, false otherwise.
+ */
+bool readFileToBody(const std::string& path, std::vector<char>& out) {
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) return false;
+
+  out.clear();
+  struct stat st;
+  // Directories open too (and read nothing): same empty body as before
+  if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+    return true;
+
+  out.resize(static_cast<size_t>(st.st_size));
+  file.read(&out[0], static_cast<std::streamsize>(out.size()));
+  out.resize(static_cast<size_t>(file.gcount()));
+  return true;
+}
+
 std::string getErrorDescription(int statusCode) {
   if (statusCode == HTTP_STATUS_FORBIDDEN) return "Forbidden\n";
   if (statusCode == HTTP_STATUS_REQUEST_ENTITY_TOO_LARGE)
     return "Request Entity Too Large\n";
+  if (statusCode == HTTP_STATUS_URI_TOO_LONG) return "URI Too Long\n";
+  if (statusCode == HTTP_STATUS_HEADER_FIELDS_TOO_LARGE)
+    return "Request Header Fields Too Large\n";
   return "Bad Request\n";  // Por defecto para 400 u otros errores de parseo
 }
 
@@ -28,21 +58,21 @@ std::string getErrorDescription(int statusCode) {
  * @param request The request.
  * @param statusCode The status code.
  * @param shouldClose Whether to close the connection.
- * @param body The body to fill the response with.
+ * @param body The body to fill the response with (taken, left empty).
  * 
  */
 void fillBaseResponse(HttpResponse& response, const HttpRequest& request,
                       int statusCode, bool shouldClose,
-                      const std::vector<char>& body) {
+                      std::vector<char>& body) {
   response.setStatusCode(statusCode);
   response.setVersion(versionToString(request.getVersion()));
   if (shouldClose)
-    response.setHeader("Connection", "close");
+    response.setHeader(HTTP_HEADER_CONNECTION, "close");
   else
-    response.setHeader("Connection", "keep-alive");
-  if (!response.hasHeader("content-type"))
+    response.setHeader(HTTP_HEADER_CONNECTION, "keep-alive");
+  if (!response.hasHeader(HTTP_HEADER_CONTENT_TYPE))
     response.setContentType(request.getPath());
-  response.setBody(body);
+  response.takeBody(body);
   if (request.getMethod() == HTTP_METHOD_HEAD) {
     response.setHeadOnly(true);
   }
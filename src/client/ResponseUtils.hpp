@@ -11,8 +11,12 @@ std::vector<char> toBody(const std::string& text);
 
 std::string getErrorDescription(int statusCode);
 
+// Whole file into `out` with a single read (sized from the file length)
+bool readFileToBody(const std::string& path, std::vector<char>& out);
+
+// `body` is moved into the response (left empty), not copied
 void fillBaseResponse(HttpResponse& response, const HttpRequest& request,
                       int statusCode, bool shouldClose,
-                      const std::vector<char>& body);
+                      std::vector<char>& body);
 
 #endif  // RESPONSE_UTILS_HPP
@@ -12,8 +12,9 @@ SessionManager::SessionManager() { std::srand(std::time(NULL)); }
 
 SessionManager::~SessionManager() {}
 
-SessionData& SessionManager::getOrCreateSession(const std::string& sessionId) {
-  cleanupSessions();  // Auto-cleanup on access
+SessionData SessionManager::getOrCreateSession(const std::string& sessionId) {
+  ScopedLock lock(_mutex);
+  cleanupSessionsLocked(3600);  // Auto-cleanup on access
 
   std::map<std::string, SessionData>::iterator it = _sessions.find(sessionId);
   if (it != _sessions.end()) {
@@ -22,10 +23,15 @@ SessionData& SessionManager::getOrCreateSession(const std::string& sessionId) {
     return it->second;
   }
 
-  return createSession();
+  return createSessionLocked();
 }
 
-SessionData& SessionManager::createSession() {
+SessionData SessionManager::createSession() {
+  ScopedLock lock(_mutex);
+  return createSessionLocked();
+}
+
+SessionData SessionManager::createSessionLocked() {
   std::string newId = generateSessionId();
 
   SessionData data;
@@ -34,7 +40,7 @@ SessionData& SessionManager::createSession() {
   data.lastAccess = std::time(NULL);
 
   _sessions[newId] = data;
-  return _sessions[newId];
+  return data;
 }
 
 std::string SessionManager::generateSessionId() const {
@@ -55,6 +61,11 @@ std::string SessionManager::generateSessionId() const {
 }
 
 void SessionManager::cleanupSessions(int timeoutSeconds) {
+  ScopedLock lock(_mutex);
+  cleanupSessionsLocked(timeoutSeconds);
+}
+
+void SessionManager::cleanupSessionsLocked(int timeoutSeconds) {
   std::time_t now = std::time(NULL);
   std::map<std::string, SessionData>::iterator it = _sessions.begin();
 
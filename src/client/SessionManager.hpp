@@ -5,6 +5,8 @@
 #include <map>
 #include <string>
 
+#include "common/Mutex.hpp"
+
 struct SessionData {
   std::string sessionId;
   int visitCount;
@@ -15,11 +17,12 @@ class SessionManager {
  public:
   static SessionManager& getInstance();
 
-  // Retrieves existing session or creates a new one
-  SessionData& getOrCreateSession(const std::string& sessionId);
+  // Retrieves existing session or creates a new one.
+  // Returns a copy: the table is shared between reactor threads.
+  SessionData getOrCreateSession(const std::string& sessionId);
 
   // Creates a strictly new session with a unique ID
-  SessionData& createSession();
+  SessionData createSession();
 
   // Helper to generate a random session ID
   std::string generateSessionId() const;
@@ -33,7 +36,11 @@ class SessionManager {
   SessionManager(const SessionManager&);
   SessionManager& operator=(const SessionManager&);
 
+  SessionData createSessionLocked();
+  void cleanupSessionsLocked(int timeoutSeconds);
+
   std::map<std::string, SessionData> _sessions;
+  Mutex _mutex;
 };
 
 #endif  // SESSION_MANAGER_HPP
@@ -6,6 +6,12 @@
 #include <sstream>
 #include <string>
 
+#include "common/Mutex.hpp"
+
+// Con worker_threads > 1 varios reactores comparten estas estructuras
+static Mutex g_sessionsMutex;
+
+// Caller must hold g_sessionsMutex (counter and rand() are shared state)
 std::string createSessionId() {
   static int counter = 0;
   std::ostringstream ss;
@@ -40,6 +46,8 @@ void addSessionCookieIfNeeded(HttpResponse& response,
   // only add cookie for 200-299 responses
   if (statusCode < 200 || statusCode > 299) return;
 
+  ScopedLock lock(g_sessionsMutex);
+
   // list of ids we created that are valid
   static std::set<std::string> validSessions;
 
@@ -51,7 +59,7 @@ void addSessionCookieIfNeeded(HttpResponse& response,
   }
 
   // see what cookie the client sends
-  std::string headerCookie = request.getHeader("cookie");
+  std::string headerCookie = request.getHeader(HTTP_HEADER_COOKIE);
   std::string receivedId = extractIdFromCookie(headerCookie);
 
   // check if the id they send exists in our list
@@ -66,6 +74,6 @@ void addSessionCookieIfNeeded(HttpResponse& response,
     std::string newId = createSessionId();
     validSessions.insert(newId);
     std::string cookieValue = "id=" + newId + "; Path=/";
-    response.setHeader("Set-Cookie", cookieValue);
+    response.setHeader(HTTP_HEADER_SET_COOKIE, cookieValue);
   }
 }
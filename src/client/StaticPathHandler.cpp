@@ -15,24 +15,9 @@
 #include "RequestProcessorUtils.hpp"
 #include "ResponseUtils.hpp"
 #include "common/StringUtils.hpp"
+#include "http/FormUpload.hpp"
 #include "http/HttpResponse.hpp"
 
-/* @brief read a file to a body.
- * 
- * read a file to a body.
- * return true if the file is read successfully, false otherwise.
- * 
-*/
-static bool readFileToBody(const std::string& path, std::vector<char>& out) {
-  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
-  if (!file.is_open()) return false;
-
-  out.clear();
-  char c; 
-  while (file.get(c)) out.push_back(c);
-  return true;
-}
-
 static bool getPathInfo(const std::string& path, bool& isDir, bool& isReg) {
   struct stat st;
   if (stat(path.c_str(), &st) != 0) return false;
@@ -140,7 +125,7 @@ static bool handleDirectory(const HttpRequest& request,
       std::vector<char> empty;
       fillBaseResponse(response, request, 302, request.shouldCloseConnection(),
                        empty);
-      response.setHeader("Location", redirectPath);
+      response.setHeader(HTTP_HEADER_LOCATION, redirectPath);
       return true;
     }
     if (!readFileToBody(indexPath, body)) {
@@ -154,7 +139,7 @@ static bool handleDirectory(const HttpRequest& request,
 
   if (location && location->getAutoIndex()) {
     body = generateAutoIndexBody(path, request.getPath());
-    response.setHeader("Content-Type", "text/html; charset=UTF-8");
+    response.setHeader(HTTP_HEADER_CONTENT_TYPE, "text/html; charset=UTF-8");
     return false;
   }
 
@@ -197,6 +182,27 @@ static bool handleRegularFile(const HttpRequest& request,
   return false;
 }
 
+/*
+ * @brief cierra un upload multipart/form-data: cada fichero del formulario
+ * queda en upload_store con su nombre.
+ */
+static bool finishFormUpload(const HttpRequest& request,
+                             const ServerConfig* server, FormUpload& form,
+                             HttpResponse& response) {
+  if (!form.isComplete()) {
+    buildErrorResponse(response, request, HTTP_STATUS_BAD_REQUEST, false,
+                       server);
+    return true;
+  }
+  if (!form.commit()) {
+    buildErrorResponse(response, request, HTTP_STATUS_INTERNAL_SERVER_ERROR,
+                       true, server);
+    return true;
+  }
+  response.setStatusCode(HTTP_STATUS_CREATED);
+  return true;
+}
+
 static bool handleUpload(const HttpRequest& request, const ServerConfig* server,
                          const LocationConfig* location,
                          const std::string& path, std::vector<char>& body,
@@ -222,6 +228,30 @@ static bool handleUpload(const HttpRequest& request, const ServerConfig* server,
     return true;
   }
 
+  // multipart/form-data: normalmente ya se separó en ficheros mientras
+  // llegaba; si no, se parsea ahora leyendo el body por bloques
+  const RequestBody& reqBody = request.getBody();
+  if (reqBody.form()) {
+    return finishFormUpload(request, server, *reqBody.form(), response);
+  }
+  std::string boundary;
+  if (MultipartParser::boundaryFrom(request.getHeader(HTTP_HEADER_CONTENT_TYPE),
+                                    boundary)) {
+    FormUpload form(uploadStore, boundary);
+    char block[65536];
+    std::size_t offset = 0;
+    while (offset < reqBody.size()) {
+      std::size_t n = reqBody.read(offset, block, sizeof(block));
+      if (n == 0 || !form.write(block, n)) {
+        buildErrorResponse(response, request,
+                           HTTP_STATUS_INTERNAL_SERVER_ERROR, true, server);
+        return true;
+      }
+      offset += n;
+    }
+    return finishFormUpload(request, server, form, response);
+  }
+
   // Ej: POST /uploads/mi_foto.png -> filename = "mi_foto.png"
   std::string filename;
   size_t lastSlash = path.find_last_of('/');
@@ -239,6 +269,18 @@ static bool handleUpload(const HttpRequest& request, const ServerConfig* server,
 
   std::string fullPath = uploadStore + filename;
 
+  // Lo normal: el body ya se fue escribiendo en un temporal de upload_store
+  // mientras llegaba (Client::handleHeadersComplete), solo falta renombrarlo
+  if (!reqBody.storedPath().empty()) {
+    if (!reqBody.commitTo(fullPath)) {
+      buildErrorResponse(response, request, HTTP_STATUS_INTERNAL_SERVER_ERROR,
+                         true, server);
+      return true;
+    }
+    response.setStatusCode(HTTP_STATUS_CREATED);
+    return true;
+  }
+
   std::ofstream outFile(fullPath.c_str(), std::ios::out | std::ios::binary);
   if (!outFile.is_open()) {
     buildErrorResponse(response, request, HTTP_STATUS_INTERNAL_SERVER_ERROR,
@@ -246,11 +288,23 @@ static bool handleUpload(const HttpRequest& request, const ServerConfig* server,
     return true;
   }
 
-  const std::vector<char>& reqBody = request.getBody();
-  if (!reqBody.empty()) {
-    outFile.write(&reqBody[0], reqBody.size());
+  // Si no, el body está en memoria o en un fichero temporal
+  // (client_body_buffer_size): se copia por bloques en ambos casos
+  char block[65536];
+  std::size_t offset = 0;
+  while (offset < reqBody.size() && outFile) {
+    std::size_t n = reqBody.read(offset, block, sizeof(block));
+    if (n == 0) break;
+    outFile.write(block, n);
+    offset += n;
   }
   outFile.close();
+  if (offset != reqBody.size() || outFile.fail()) {
+    unlink(fullPath.c_str());
+    buildErrorResponse(response, request, HTTP_STATUS_INTERNAL_SERVER_ERROR,
+                       true, server);
+    return true;
+  }
 
   response.setStatusCode(HTTP_STATUS_CREATED);
   return true;
@@ -0,0 +1,48 @@
+#include "BufferPool.hpp"
+
+BufferPool::BufferPool() {}
+
+BufferPool::~BufferPool() {
+  for (size_t c = 0; c < CLASSES; ++c) {
+    for (size_t i = 0; i < free_[c].size(); ++i) delete[] free_[c][i];
+  }
+}
+
+size_t BufferPool::roundUp(size_t size) {
+  if (size > MAX_SIZE) return size;
+  size_t capacity = MIN_SIZE;
+  while (capacity < size) capacity <<= 1;
+  return capacity;
+}
+
+size_t BufferPool::classOf(size_t capacity) {
+  size_t c = 0;
+  for (size_t s = MIN_SIZE; s < capacity; s <<= 1) ++c;
+  return c;
+}
+
+char* BufferPool::acquire(size_t size) {
+  size_t capacity = roundUp(size);
+  if (capacity > MAX_SIZE) return new char[capacity];
+
+  std::vector<char*>& list = free_[classOf(capacity)];
+  if (list.empty()) return new char[capacity];
+  char* buffer = list.back();
+  list.pop_back();
+  return buffer;
+}
+
+void BufferPool::release(char* buffer, size_t capacity) {
+  if (buffer == NULL) return;
+  if (capacity > MAX_SIZE) {
+    delete[] buffer;
+    return;
+  }
+
+  std::vector<char*>& list = free_[classOf(capacity)];
+  if (list.size() * capacity >= MAX_IDLE_BYTES) {
+    delete[] buffer;
+    return;
+  }
+  list.push_back(buffer);
+}
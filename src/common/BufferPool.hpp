@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Free lists of receive buffers, one pool per reactor.
+ *
+ * Buffers come in power-of-two size classes from MIN_SIZE to MAX_SIZE.
+ * Releasing a buffer keeps it for the next connection (up to
+ * MAX_IDLE_BYTES per class) instead of returning it to malloc, so a
+ * keep-alive connection that goes idle costs no buffer memory and the
+ * next request picks up an already allocated one.
+ *
+ * Requests above MAX_SIZE (a header block or chunk that does not fit) are
+ * plain new[] / delete[], never kept.
+ *
+ * Not thread safe: each reactor owns its pool and every client it serves
+ * runs on the same thread.
+ */
+class BufferPool {
+ public:
+  static const size_t MIN_SIZE = 4096;
+  static const size_t MAX_SIZE = 65536;
+  static const size_t MAX_IDLE_BYTES = 1024 * 1024;  // per size class
+
+  BufferPool();
+  ~BufferPool();
+
+  // Size of the buffer acquire(size) returns: `size` rounded up to a class
+  static size_t roundUp(size_t size);
+
+  // At least `size` bytes; the real capacity is roundUp(size)
+  char* acquire(size_t size);
+  // `capacity` must be the roundUp() value the buffer was acquired with
+  void release(char* buffer, size_t capacity);
+
+ private:
+  static const size_t CLASSES = 5;  // 4K, 8K, 16K, 32K, 64K
+
+  std::vector<char*> free_[CLASSES];
+
+  static size_t classOf(size_t capacity);
+
+  BufferPool(const BufferPool&);
+  BufferPool& operator=(const BufferPool&);
+};
@@ -0,0 +1,19 @@
+#include "Mutex.hpp"
+
+#include <stdexcept>
+
+Mutex::Mutex() {
+  if (pthread_mutex_init(&mutex_, NULL) != 0) {
+    throw std::runtime_error("Failed to initialize mutex");
+  }
+}
+
+Mutex::~Mutex() { pthread_mutex_destroy(&mutex_); }
+
+void Mutex::lock() { pthread_mutex_lock(&mutex_); }
+
+void Mutex::unlock() { pthread_mutex_unlock(&mutex_); }
+
+ScopedLock::ScopedLock(Mutex& mutex) : mutex_(mutex) { mutex_.lock(); }
+
+ScopedLock::~ScopedLock() { mutex_.unlock(); }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <pthread.h>
+
+/**
+ * @brief Thin RAII wrapper over pthread_mutex_t (C++98 has no std::mutex).
+ *
+ * Used to protect the few pieces of process-wide state that are shared
+ * between reactor threads (sessions, reaped CGI exit statuses).
+ */
+class Mutex {
+ public:
+  Mutex();
+  ~Mutex();
+
+  void lock();
+  void unlock();
+
+ private:
+  pthread_mutex_t mutex_;
+
+  // Disable copying
+  Mutex(const Mutex&);
+  Mutex& operator=(const Mutex&);
+};
+
+/**
+ * @brief Locks a Mutex for the lifetime of the scope.
+ */
+class ScopedLock {
+ public:
+  explicit ScopedLock(Mutex& mutex);
+  ~ScopedLock();
+
+ private:
+  Mutex& mutex_;
+
+  // Disable copying
+  ScopedLock(const ScopedLock&);
+  ScopedLock& operator=(const ScopedLock&);
+};
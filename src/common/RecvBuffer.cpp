@@ -0,0 +1,86 @@
+#include "RecvBuffer.hpp"
+
+#include <cstring>
+
+#include "BufferPool.hpp"
+
+RecvBuffer::RecvBuffer()
+    : pool_(NULL), data_(NULL), capacity_(0), start_(0), end_(0) {}
+
+RecvBuffer::~RecvBuffer() {
+  start_ = end_ = 0;
+  release();
+}
+
+void RecvBuffer::setPool(BufferPool* pool) { pool_ = pool; }
+
+const char* RecvBuffer::data() const { return data_ + start_; }
+
+size_t RecvBuffer::size() const { return end_ - start_; }
+
+bool RecvBuffer::empty() const { return end_ == start_; }
+
+size_t RecvBuffer::capacity() const { return capacity_; }
+
+char RecvBuffer::operator[](size_t i) const { return data_[start_ + i]; }
+
+void RecvBuffer::consume(size_t n) {
+  start_ += n;
+  // Todo leido: volver al principio, el siguiente recv no necesita compactar
+  if (start_ >= end_) start_ = end_ = 0;
+}
+
+char* RecvBuffer::prepare(size_t min, size_t& room) {
+  if (capacity_ - end_ < min) {
+    size_t unread = size();
+    if (data_ != NULL && capacity_ - unread >= min) {
+      std::memmove(data_, data_ + start_, unread);
+      start_ = 0;
+      end_ = unread;
+    } else {
+      // Grow at least x2: a line that keeps not fitting is not copied again
+      // on every recv()
+      size_t wanted = unread + min;
+      if (wanted < capacity_ * 2) wanted = capacity_ * 2;
+      reallocate(wanted);
+    }
+  }
+  room = capacity_ - end_;
+  return data_ + end_;
+}
+
+void RecvBuffer::commit(size_t n) { end_ += n; }
+
+void RecvBuffer::append(const char* bytes, size_t len) {
+  if (len == 0) return;
+  size_t room = 0;
+  std::memcpy(prepare(len, room), bytes, len);
+  commit(len);
+}
+
+void RecvBuffer::release() {
+  if (data_ == NULL || !empty()) return;
+  if (pool_)
+    pool_->release(data_, capacity_);
+  else
+    delete[] data_;
+  data_ = NULL;
+  capacity_ = 0;
+  start_ = end_ = 0;
+}
+
+void RecvBuffer::reallocate(size_t capacity) {
+  capacity = BufferPool::roundUp(capacity);
+  char* fresh = pool_ ? pool_->acquire(capacity) : new char[capacity];
+  size_t unread = size();
+  if (unread > 0) std::memcpy(fresh, data_ + start_, unread);
+
+  if (pool_)
+    pool_->release(data_, capacity_);
+  else
+    delete[] data_;
+  data_ = fresh;
+  capacity_ = capacity;
+  start_ = 0;
+  end_ = unread;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+class BufferPool;
+
+/**
+ * @brief Receive buffer of a connection: recv() writes at the end, the
+ * parser reads from the front.
+ *
+ * [ consumed | unread bytes (data(), size()) | writable (prepare()) ]
+ *   0        start_                          end_                capacity_
+ *
+ * - consume(n) only moves start_: no erase(0, n) per parsed line.
+ * - prepare(n) compacts (moves the unread bytes to the front) or grows
+ *   only when fewer than n bytes are writable.
+ * - the storage comes from a BufferPool (or new[] without one); release()
+ *   gives it back as soon as nothing is left unread.
+ */
+class RecvBuffer {
+ public:
+  RecvBuffer();
+  ~RecvBuffer();
+
+  // Call before the first byte is written
+  void setPool(BufferPool* pool);
+
+  const char* data() const;
+  size_t size() const;  // unread bytes
+  bool empty() const;
+  size_t capacity() const;
+  char operator[](size_t i) const;
+
+  void consume(size_t n);
+
+  // At least `min` writable bytes at the returned pointer, `room` of them
+  char* prepare(size_t min, size_t& room);
+  void commit(size_t n);  // n bytes were written after prepare()
+  void append(const char* bytes, size_t len);
+
+  // Returns the storage to the pool, only if there is nothing unread
+  void release();
+
+ private:
+  BufferPool* pool_;
+  char* data_;
+  size_t capacity_;
+  size_t start_;
+  size_t end_;
+
+  void reallocate(size_t capacity);
+
+  RecvBuffer(const RecvBuffer&);
+  RecvBuffer& operator=(const RecvBuffer&);
+};
@@ -0,0 +1,49 @@
+#include "SharedBuffer.hpp"
+
+SharedBuffer::SharedBuffer() : block_(NULL) {}
+
+SharedBuffer::SharedBuffer(const SharedBuffer& other) : block_(other.block_) {
+  if (block_) __sync_add_and_fetch(&block_->refs, 1);
+}
+
+SharedBuffer& SharedBuffer::operator=(const SharedBuffer& other) {
+  if (block_ != other.block_) {
+    if (other.block_) __sync_add_and_fetch(&other.block_->refs, 1);
+    release();
+    block_ = other.block_;
+  }
+  return *this;
+}
+
+SharedBuffer::~SharedBuffer() { release(); }
+
+void SharedBuffer::release() {
+  if (block_ && __sync_sub_and_fetch(&block_->refs, 1) == 0) delete block_;
+  block_ = NULL;
+}
+
+void SharedBuffer::adopt(std::vector<char>& bytes) {
+  release();
+  if (bytes.empty()) return;
+  block_ = new Block();
+  block_->refs = 1;
+  block_->bytes.swap(bytes);
+}
+
+void SharedBuffer::assign(const char* data, size_t len) {
+  release();
+  if (len == 0) return;
+  block_ = new Block();
+  block_->refs = 1;
+  block_->bytes.assign(data, data + len);
+}
+
+void SharedBuffer::clear() { release(); }
+
+const char* SharedBuffer::data() const {
+  return block_ ? &block_->bytes[0] : NULL;
+}
+
+size_t SharedBuffer::size() const { return block_ ? block_->bytes.size() : 0; }
+
+bool SharedBuffer::empty() const { return block_ == NULL; }
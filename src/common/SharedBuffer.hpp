@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Reference counted, immutable byte buffer.
+ *
+ * Copies share the bytes (O(1), one atomic increment) instead of
+ * duplicating them, so a response body read once from disk travels from
+ * HttpResponse to the client output queue without being copied again.
+ *
+ * The bytes are never modified once they are in the buffer: assign(),
+ * adopt() and clear() detach this handle from the shared block and leave
+ * the other copies untouched.
+ */
+class SharedBuffer {
+ public:
+  SharedBuffer();
+  SharedBuffer(const SharedBuffer& other);
+  SharedBuffer& operator=(const SharedBuffer& other);
+  ~SharedBuffer();
+
+  // Takes the contents of `bytes` without copying; `bytes` is left empty
+  void adopt(std::vector<char>& bytes);
+  void assign(const char* data, size_t len);
+  void clear();
+
+  const char* data() const;
+  size_t size() const;
+  bool empty() const;
+
+ private:
+  struct Block {
+    std::vector<char> bytes;
+    volatile int refs;
+  };
+
+  Block* block_;  // NULL when empty
+
+  void release();
+};
@@ -0,0 +1,89 @@
+#include "TimerWheel.hpp"
+
+#include <time.h>
+
+TimerWheel::TimerWheel() : slots_(new Node[SLOTS]), current_tick_(0) {
+  for (size_t i = 0; i < SLOTS; ++i) {
+    slots_[i].prev = &slots_[i];
+    slots_[i].next = &slots_[i];
+  }
+  current_tick_ = nowMs() / TICK_MS;
+}
+
+TimerWheel::~TimerWheel() {
+  // Detach every node still armed: their owners may outlive the wheel
+  for (size_t i = 0; i < SLOTS; ++i) {
+    Node* head = &slots_[i];
+    while (head->next != head) {
+      head->next->unlink();
+    }
+    head->prev = NULL;
+    head->next = NULL;
+  }
+  delete[] slots_;
+}
+
+long TimerWheel::nowMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<long>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+time_t TimerWheel::nowSec() { return static_cast<time_t>(nowMs() / 1000); }
+
+void TimerWheel::insert(Node& node) {
+  // Never schedule behind the cursor, that slot was already swept
+  long tick = node.tick < current_tick_ ? current_tick_ : node.tick;
+  Node* head = &slots_[static_cast<size_t>(tick) % SLOTS];
+
+  node.prev = head->prev;
+  node.next = head;
+  head->prev->next = &node;
+  head->prev = &node;
+}
+
+void TimerWheel::arm(Node& node, long deadline_ms) {
+  node.unlink();
+  node.deadline_ms = deadline_ms;
+  // Round up: a timer never fires before its deadline
+  node.tick = (deadline_ms + TICK_MS - 1) / TICK_MS;
+  insert(node);
+}
+
+void TimerWheel::cancel(Node& node) { node.unlink(); }
+
+void TimerWheel::expire(long now_ms, std::vector<Expired>& expired) {
+  long now_tick = now_ms / TICK_MS;
+  if (now_tick < current_tick_) return;
+
+  // After a long stall one full revolution already visits every slot
+  long ticks = now_tick - current_tick_ + 1;
+  if (ticks > static_cast<long>(SLOTS)) ticks = SLOTS;
+
+  for (long t = 0; t < ticks; ++t) {
+    Node* head = &slots_[static_cast<size_t>(current_tick_ + t) % SLOTS];
+    Node* node = head->next;
+    while (node != head) {
+      Node* next = node->next;
+      if (node->tick <= now_tick) {
+        node->unlink();
+        expired.push_back(Expired(node->fd, node->kind));
+      }
+      node = next;
+    }
+  }
+  current_tick_ = now_tick + 1;
+}
+
+int TimerWheel::nextTimeoutMs(long now_ms, int max_ms) const {
+  for (long tick = current_tick_;; ++tick) {
+    long wait = tick * TICK_MS - now_ms;
+    if (wait >= max_ms) break;
+
+    const Node* head = &slots_[static_cast<size_t>(tick) % SLOTS];
+    if (head->next != head) {
+      return wait < 0 ? 0 : static_cast<int>(wait);
+    }
+  }
+  return max_ms;
+}
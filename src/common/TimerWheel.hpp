@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+#include <vector>
+
+/**
+ * @brief Hashed timing wheel for connection / CGI deadlines.
+ *
+ * Deadlines are CLOCK_MONOTONIC milliseconds: a wall-clock step (NTP,
+ * settimeofday) neither stalls the wheel nor expires everything at once.
+ * Client and CgiProcess keep their timestamps with nowSec(), the same clock.
+ * Each slot covers TICK_MS; a deadline lands in slot (tick % SLOTS) and
+ * deadlines further than one revolution simply stay there until their tick.
+ *
+ * - arm / cancel: O(1), nodes are intrusive (embedded in their owner).
+ * - expire: O(slots elapsed + nodes in them), not O(connections).
+ * - nextTimeoutMs: looks at most max_ms / TICK_MS slots ahead; used as the
+ *   epoll_wait() timeout instead of a fixed polling interval.
+ */
+class TimerWheel {
+ public:
+  static const long TICK_MS = 100;
+  static const size_t SLOTS = 1024;  // ~102 s per revolution
+
+  struct Node {
+    Node* prev;
+    Node* next;
+    long deadline_ms;
+    long tick;
+    int fd;    // payload: owner fd
+    int kind;  // payload: caller defined timer type
+
+    Node() : prev(NULL), next(NULL), deadline_ms(0), tick(0), fd(-1), kind(0) {}
+    ~Node() { unlink(); }
+
+    bool isArmed() const { return next != NULL; }
+    void unlink() {
+      if (next == NULL) return;
+      prev->next = next;
+      next->prev = prev;
+      prev = NULL;
+      next = NULL;
+    }
+
+   private:
+    Node(const Node&);
+    Node& operator=(const Node&);
+  };
+
+  // What expire() hands back: copied out so that handling one expiration
+  // may freely destroy the owner of another one.
+  struct Expired {
+    int fd;
+    int kind;
+    Expired(int f, int k) : fd(f), kind(k) {}
+  };
+
+  TimerWheel();
+  ~TimerWheel();
+
+  // (Re)schedules node. Deadlines already in the past fire on next expire().
+  void arm(Node& node, long deadline_ms);
+  void cancel(Node& node);
+
+  void expire(long now_ms, std::vector<Expired>& expired);
+
+  // Milliseconds until the first non-empty slot, capped to max_ms.
+  int nextTimeoutMs(long now_ms, int max_ms) const;
+
+  static long nowMs();
+  static time_t nowSec();  // nowMs() / 1000
+
+ private:
+  Node* slots_;  // SLOTS circular sentinel lists
+  long current_tick_;
+
+  void insert(Node& node);
+
+  // Disable copying
+  TimerWheel(const TimerWheel&);
+  TimerWheel& operator=(const TimerWheel&);
+};
@@ -1,5 +1,6 @@
 #ifndef WEBSERV_NAMESPACES_HPP
 #define WEBSERV_NAMESPACES_HPP
+#include <climits>
 #include <string>
 
 namespace config {
@@ -93,6 +94,34 @@ static const std::string duplicate_server_config =
     "server_name)";
 static const std::string invalid_parameters_in_location =
     "Location modifiers ('=' or '^~') are not supported by design: ";
+static const std::string unknown_global_directive =
+    "Unknown directive outside of server block: ";
+static const std::string invalid_worker_threads =
+    "worker_threads must be 'auto' or a number between 1 and 256";
+static const std::string invalid_worker_processes =
+    "worker_processes must be 'auto' or a number between 1 and 256";
+static const std::string invalid_edge_triggered =
+    "edge_triggered must be 'on' or 'off'";
+static const std::string invalid_max_connections =
+    "max_connections must be a number between 1 and 1048576";
+static const std::string invalid_event_backend =
+    "event_backend must be 'epoll' or 'io_uring'";
+static const std::string invalid_min_rate =
+    "client_body_min_rate must be a size in bytes per second (e.g. 512 or 1k)";
+static const std::string invalid_body_buffer_size =
+    "client_body_buffer_size must be a size greater than 0 (e.g. 16k)";
+static const std::string invalid_header_buffers =
+    "large_client_header_buffers must be a number and a size greater than 0 "
+    "(e.g. 4 8k)";
+static const std::string invalid_max_header_count =
+    "client_max_header_count must be a number greater than 0";
+static const std::string invalid_pipeline_depth =
+    "pipeline_depth must be a number between 1 and 1024";
+static const std::string invalid_listen_option =
+    "Invalid 'listen' parameter (expected deferred[=s], fastopen=N, "
+    "rcvbuf=size, sndbuf=size or notsent_lowat=size): ";
+static const std::string invalid_timeout =
+    "Invalid timeout: expected seconds between 1 and 86400 (e.g. 60 or 60s): ";
 }  // namespace errors
 
 namespace section {
@@ -124,12 +153,56 @@ static const int default_port_listen = 80;
 static const std::string default_host_name = "127.0.0.1";
 static const size_t max_body_size = 1048576;
 static const int max_port = 65535;
+static const std::string listen_deferred = "deferred";
+static const std::string listen_fastopen = "fastopen";
+static const std::string listen_rcvbuf = "rcvbuf";
+static const std::string listen_sndbuf = "sndbuf";
+static const std::string listen_notsent_lowat = "notsent_lowat";
+static const int default_defer_accept = 60;
+static const int max_fastopen_queue = 65535;
+static const long max_listen_buffer = INT_MAX;  // setsockopt() takes an int
 static const std::string method_get = "GET";
 static const std::string method_post = "POST";
 static const std::string method_delete = "DELETE";
 static const std::string method_head = "HEAD";
 static const std::string cgi = "cgi";
 static const std::string cgi_fast = "fastcgi_pass";
+static const std::string worker_threads = "worker_threads";
+static const std::string worker_processes = "worker_processes";
+static const std::string worker_auto = "auto";
+static const int default_worker_threads = 1;
+static const int max_worker_threads = 256;
+static const int default_worker_processes = 1;
+static const int max_worker_processes = 256;
+static const std::string edge_triggered = "edge_triggered";
+static const std::string max_connections = "max_connections";
+static const int default_max_connections = 1024;
+static const int max_max_connections = 1048576;
+static const std::string event_backend = "event_backend";
+static const std::string backend_epoll = "epoll";
+static const std::string backend_io_uring = "io_uring";
+static const std::string flag_on = "on";
+static const std::string flag_off = "off";
+static const std::string client_timeout = "client_timeout";
+static const std::string cgi_timeout = "cgi_timeout";
+static const std::string client_header_timeout = "client_header_timeout";
+static const std::string client_body_timeout = "client_body_timeout";
+static const std::string keepalive_timeout = "keepalive_timeout";
+static const std::string send_timeout = "send_timeout";
+static const std::string client_body_min_rate = "client_body_min_rate";
+static const std::string client_body_buffer_size = "client_body_buffer_size";
+static const long default_client_body_buffer_size = 16384;
+static const std::string large_client_header_buffers =
+    "large_client_header_buffers";
+static const int default_header_buffers = 4;
+static const long default_header_buffer_size = 8192;
+static const std::string client_max_header_count = "client_max_header_count";
+static const int default_max_header_count = 100;
+static const std::string pipeline_depth = "pipeline_depth";
+static const int default_pipeline_depth = 32;
+static const int max_pipeline_depth = 1024;
+static const int default_client_timeout = 60;
+static const int max_timeout_seconds = 86400;
 }  // namespace section
 
 enum ParserState { OUTSIDE_BLOCK, IN_SERVER, IN_LOCATION };
@@ -29,6 +29,8 @@ const std::vector<ServerConfig>& ConfigParser::getServers() const {
   return servers_;
 }
 
+const GlobalConfig& ConfigParser::getGlobalConfig() const { return global_; }
+
 //	============= PRIVATE CONSTRUCTORS ===============
 
 /**
@@ -74,7 +76,8 @@ ConfigParser::ConfigParser(const ConfigParser& other)
       clean_file_str_(other.clean_file_str_),
       servers_count_(other.servers_count_),
       raw_server_blocks_(other.raw_server_blocks_),
-      servers_(other.servers_) {}
+      servers_(other.servers_),
+      global_(other.global_) {}
 
 ConfigParser& ConfigParser::operator=(const ConfigParser& other) {
   if (this != &other) {
@@ -84,6 +87,7 @@ ConfigParser& ConfigParser::operator=(const ConfigParser& other) {
     std::swap(servers_count_, tmp.servers_count_);
     std::swap(raw_server_blocks_, tmp.raw_server_blocks_);
     std::swap(servers_, tmp.servers_);
+    std::swap(global_, tmp.global_);
   }
   return *this;
 }
@@ -209,12 +213,8 @@ void ConfigParser::splitContentIntoServerBlocks(
 
   while ((currentPos = content.find(typeOfExtraction, currentPos)) !=
          std::string::npos) {
-    // Check if there is anything between blocks
-    std::string skipped = content.substr(lastPos, currentPos - lastPos);
-    if (skipped.find_first_not_of(" \t\n\r") != std::string::npos) {
-      throw ConfigException("Unknown directive outside of server block: " +
-                            skipped);
-    }
+    // Anything between blocks must be a global directive
+    parseGlobalDirectives(content.substr(lastPos, currentPos - lastPos));
 
     size_t braceStart = content.find('{', currentPos);
     if (braceStart == std::string::npos) {
@@ -254,18 +254,277 @@ void ConfigParser::splitContentIntoServerBlocks(
     ++countServers;
   }
 
-  // Check if there is anything after the last block
+  // Anything after the last block must be a global directive too
   if (lastPos < content.size()) {
-    std::string skipped = content.substr(lastPos);
-    if (skipped.find_first_not_of(" \t\n\r") != std::string::npos) {
-      throw ConfigException("Unknown directive after server blocks: " +
-                            skipped);
-    }
+    parseGlobalDirectives(content.substr(lastPos));
   }
 
   servers_count_ = raw_server_blocks_.size();
 }
 
+/**
+ * Parses the directives found outside of every server { } block.
+ * worker_threads 4;
+ * Anything that is not a known global directive is an error.
+ * @param content Text between (or around) server blocks
+ */
+void ConfigParser::parseGlobalDirectives(const std::string& content) {
+  std::stringstream ss(content);
+  std::string line;
+
+  while (std::getline(ss, line)) {
+    line = config::utils::trimLine(line);
+    if (line.find_first_not_of(" \t") == std::string::npos) continue;
+    validateDirectiveLine(line);
+
+    std::vector<std::string> tokens = config::utils::tokenize(line);
+    if (tokens.empty()) continue;
+
+    const std::string& directive = tokens[0];
+    if (directive == config::section::worker_threads) {
+      parseWorkerThreads(tokens);
+    } else if (directive == config::section::worker_processes) {
+      parseWorkerProcesses(tokens);
+    } else if (directive == config::section::edge_triggered) {
+      parseEdgeTriggered(tokens);
+    } else if (directive == config::section::event_backend) {
+      parseEventBackend(tokens);
+    } else if (directive == config::section::max_connections) {
+      parseMaxConnections(tokens);
+    } else if (directive == config::section::client_timeout) {
+      parseClientTimeout(tokens);
+    } else if (directive == config::section::client_header_timeout ||
+               directive == config::section::client_body_timeout ||
+               directive == config::section::keepalive_timeout ||
+               directive == config::section::send_timeout) {
+      parsePhaseTimeout(tokens);
+    } else if (directive == config::section::client_body_min_rate) {
+      parseClientBodyMinRate(tokens);
+    } else if (directive == config::section::client_body_buffer_size) {
+      parseClientBodyBufferSize(tokens);
+    } else if (directive == config::section::large_client_header_buffers) {
+      parseLargeClientHeaderBuffers(tokens);
+    } else if (directive == config::section::client_max_header_count) {
+      parseClientMaxHeaderCount(tokens);
+    } else if (directive == config::section::pipeline_depth) {
+      parsePipelineDepth(tokens);
+    } else {
+      throw ConfigException(config::errors::unknown_global_directive + line);
+    }
+  }
+}
+
+/**
+ * Resolves the value of worker_threads / worker_processes.
+ * "auto" means one per online CPU (capped to max).
+ * Range validation is left to GlobalConfig setters.
+ */
+static int resolveWorkerCount(const std::vector<std::string>& tokens,
+                              const std::string& error, int max) {
+  if (tokens.size() != 2) {
+    throw ConfigException(error);
+  }
+  std::string value = config::utils::removeSemicolon(tokens[1]);
+  if (value == config::section::worker_auto) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    if (cpus > max) cpus = max;
+    return static_cast<int>(cpus);
+  }
+  return config::utils::stringToInt(value);
+}
+
+/**
+ * worker_threads 4;     -> 4 reactors
+ * worker_threads auto;  -> one reactor per online CPU
+ */
+void ConfigParser::parseWorkerThreads(const std::vector<std::string>& tokens) {
+  global_.setWorkerThreads(
+      resolveWorkerCount(tokens, config::errors::invalid_worker_threads,
+                         config::section::max_worker_threads));
+}
+
+/**
+ * worker_processes 4;     -> master + 4 forked workers
+ * worker_processes auto;  -> one worker per online CPU
+ */
+void ConfigParser::parseWorkerProcesses(
+    const std::vector<std::string>& tokens) {
+  global_.setWorkerProcesses(
+      resolveWorkerCount(tokens, config::errors::invalid_worker_processes,
+                         config::section::max_worker_processes));
+}
+
+/**
+ * Resolves an on|off flag directive, throws error otherwise.
+ */
+static bool resolveOnOff(const std::vector<std::string>& tokens,
+                         const std::string& error) {
+  if (tokens.size() != 2) {
+    throw ConfigException(error);
+  }
+  std::string value = config::utils::removeSemicolon(tokens[1]);
+  if (value == config::section::flag_on) return true;
+  if (value == config::section::flag_off) return false;
+  throw ConfigException(error);
+}
+
+/**
+ * edge_triggered on;   -> client sockets registered with EPOLLET
+ * edge_triggered off;  -> level triggered (default)
+ */
+void ConfigParser::parseEdgeTriggered(const std::vector<std::string>& tokens) {
+  global_.setEdgeTriggered(
+      resolveOnOff(tokens, config::errors::invalid_edge_triggered));
+}
+
+/**
+ * event_backend epoll;     -> epoll_wait() readiness loop (default)
+ * event_backend io_uring;  -> io_uring POLL_ADD, falls back to epoll at
+ *                             runtime if the kernel refuses io_uring
+ */
+void ConfigParser::parseEventBackend(const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_event_backend);
+  }
+  global_.setEventBackend(config::utils::removeSemicolon(tokens[1]));
+}
+
+/**
+ * max_connections 1024;  -> each reactor stops accepting at 1024 clients
+ *                           (listeners leave the poll set until one closes)
+ */
+void ConfigParser::parseMaxConnections(const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_max_connections);
+  }
+  global_.setMaxConnections(
+      config::utils::stringToInt(config::utils::removeSemicolon(tokens[1])));
+}
+
+/**
+ * Resolves a timeout value in seconds: "60;" or "60s;".
+ * @return seconds in [1, max_timeout_seconds]
+ */
+static int resolveSeconds(const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_timeout + tokens[0]);
+  }
+  std::string value = config::utils::removeSemicolon(tokens[1]);
+  if (!value.empty() && value[value.size() - 1] == 's') {
+    value.erase(value.size() - 1);
+  }
+  int seconds = config::utils::stringToInt(value);
+  if (seconds < 1 || seconds > config::section::max_timeout_seconds) {
+    throw ConfigException(config::errors::invalid_timeout + tokens[0]);
+  }
+  return seconds;
+}
+
+/**
+ * client_timeout 60s;  -> idle connections are closed after 60 seconds
+ */
+void ConfigParser::parseClientTimeout(const std::vector<std::string>& tokens) {
+  global_.setClientTimeout(resolveSeconds(tokens));
+}
+
+/**
+ * client_header_timeout 10s;  -> whole request head, not extended per byte
+ * client_body_timeout 30s;    -> between two reads of the body
+ * keepalive_timeout 15s;      -> idle between two requests
+ * send_timeout 30s;           -> between two writes of the response
+ * Unset ones fall back to client_timeout.
+ */
+void ConfigParser::parsePhaseTimeout(const std::vector<std::string>& tokens) {
+  const std::string& directive = tokens[0];
+  int seconds = resolveSeconds(tokens);
+
+  if (directive == config::section::client_header_timeout) {
+    global_.setClientHeaderTimeout(seconds);
+  } else if (directive == config::section::client_body_timeout) {
+    global_.setClientBodyTimeout(seconds);
+  } else if (directive == config::section::keepalive_timeout) {
+    global_.setKeepaliveTimeout(seconds);
+  } else {
+    global_.setSendTimeout(seconds);
+  }
+}
+
+/**
+ * client_body_min_rate 1k;  -> uploads slower than 1 KiB/s (measured over a
+ *                              few seconds) are dropped
+ */
+void ConfigParser::parseClientBodyMinRate(
+    const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_min_rate);
+  }
+  global_.setClientBodyMinRate(
+      config::utils::parseSize(config::utils::removeSemicolon(tokens[1])));
+}
+
+/**
+ * client_body_buffer_size 16k;  -> request bodies up to 16 KiB stay in
+ *                                  memory, larger ones are written to an
+ *                                  unlinked temp file as they arrive
+ */
+void ConfigParser::parseClientBodyBufferSize(
+    const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_body_buffer_size);
+  }
+  global_.setClientBodyBufferSize(
+      config::utils::parseSize(config::utils::removeSemicolon(tokens[1])));
+}
+
+/**
+ * large_client_header_buffers 4 8k;  -> request line and each header line
+ *                                      up to 8 KiB (414 / 431 beyond), the
+ *                                      whole head up to 4 * 8 KiB (431)
+ */
+void ConfigParser::parseLargeClientHeaderBuffers(
+    const std::vector<std::string>& tokens) {
+  if (tokens.size() != 3) {
+    throw ConfigException(config::errors::invalid_header_buffers);
+  }
+  global_.setLargeClientHeaderBuffers(
+      config::utils::stringToInt(tokens[1]),
+      config::utils::parseSize(config::utils::removeSemicolon(tokens[2])));
+}
+
+/**
+ * client_max_header_count 100;  -> requests with more header lines get 431
+ */
+void ConfigParser::parseClientMaxHeaderCount(
+    const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_max_header_count);
+  }
+  global_.setClientMaxHeaderCount(
+      config::utils::stringToInt(config::utils::removeSemicolon(tokens[1])));
+}
+
+/**
+ * pipeline_depth 32;  -> a client with 32 responses still unsent is not
+ *                        read (nor its pipelined requests processed) until
+ *                        they are flushed
+ */
+void ConfigParser::parsePipelineDepth(const std::vector<std::string>& tokens) {
+  if (tokens.size() != 2) {
+    throw ConfigException(config::errors::invalid_pipeline_depth);
+  }
+  global_.setPipelineDepth(
+      config::utils::stringToInt(config::utils::removeSemicolon(tokens[1])));
+}
+
+/**
+ * cgi_timeout 30s;  -> CGI scripts of this server are killed (504) after 30s
+ */
+void ConfigParser::parseCgiTimeout(ServerConfig& server,
+                                   const std::vector<std::string>& tokens) {
+  server.setCgiTimeout(resolveSeconds(tokens));
+}
+
 void ConfigParser::parseAllServerBlocks() {
   for (size_t i = 0; i < raw_server_blocks_.size(); ++i) {
     ServerConfig server = parseSingleServerBlock(raw_server_blocks_[i]);
@@ -279,11 +538,69 @@ void ConfigParser::parseAllServerBlocks() {
   }
 }
 
+/**
+ * Socket parameters after the address of `listen` (nginx-like):
+ *   deferred[=s]      -> TCP_DEFER_ACCEPT, not woken until request bytes arrive
+ *   fastopen=N        -> TCP_FASTOPEN with a queue of N pending SYNs
+ *   rcvbuf=size       -> SO_RCVBUF
+ *   sndbuf=size       -> SO_SNDBUF
+ *   notsent_lowat=size -> TCP_NOTSENT_LOWAT
+ */
+static ListenOptions parseListenOptions(
+    const std::vector<std::string>& tokens) {
+  ListenOptions options;
+
+  for (size_t i = 2; i < tokens.size(); ++i) {
+    std::string param = config::utils::removeSemicolon(tokens[i]);
+    size_t eq = param.find('=');
+    std::string name = param.substr(0, eq);
+    std::string value = eq == std::string::npos ? "" : param.substr(eq + 1);
+
+    if (name == config::section::listen_deferred) {
+      if (value.empty()) {
+        options.defer_accept = config::section::default_defer_accept;
+        continue;
+      }
+      if (value[value.size() - 1] == 's') value.erase(value.size() - 1);
+      options.defer_accept = config::utils::stringToInt(value);
+      if (options.defer_accept < 1 ||
+          options.defer_accept > config::section::max_timeout_seconds) {
+        throw ConfigException(config::errors::invalid_listen_option + param);
+      }
+    } else if (name == config::section::listen_fastopen && !value.empty()) {
+      options.fastopen = config::utils::stringToInt(value);
+      if (options.fastopen < 1 ||
+          options.fastopen > config::section::max_fastopen_queue) {
+        throw ConfigException(config::errors::invalid_listen_option + param);
+      }
+    } else if ((name == config::section::listen_rcvbuf ||
+                name == config::section::listen_sndbuf ||
+                name == config::section::listen_notsent_lowat) &&
+               !value.empty()) {
+      long bytes = config::utils::parseSize(value);
+      if (bytes < 1 || bytes > config::section::max_listen_buffer) {
+        throw ConfigException(config::errors::invalid_listen_option + param);
+      }
+      if (name == config::section::listen_rcvbuf) {
+        options.rcvbuf = static_cast<int>(bytes);
+      } else if (name == config::section::listen_sndbuf) {
+        options.sndbuf = static_cast<int>(bytes);
+      } else {
+        options.notsent_lowat = static_cast<int>(bytes);
+      }
+    } else {
+      throw ConfigException(config::errors::invalid_listen_option + param);
+    }
+  }
+  return options;
+}
+
 void ConfigParser::parseListen(ServerConfig& server,
                                const std::vector<std::string>& tokens) {
   if (tokens.size() < 2) {
     throw ConfigException(config::errors::missing_args_in_listen);
   }
+  server.setListenOptions(parseListenOptions(tokens));
   std::string value = config::utils::removeSemicolon(tokens[1]);
   size_t pos = value.find(':');
 
@@ -647,7 +964,8 @@ ServerConfig ConfigParser::parseSingleServerBlock(
         directive == config::section::host ||
         directive == config::section::server_name ||
         directive == config::section::root ||
-        directive == config::section::client_max_body_size) {
+        directive == config::section::client_max_body_size ||
+        directive == config::section::cgi_timeout) {
       if (parsedDirectives.count(directive)) {
         throw ConfigException("Duplicate directive '" + directive +
                               "' in server block: " + line);
@@ -669,6 +987,8 @@ ServerConfig ConfigParser::parseSingleServerBlock(
       parseMaxSizeBody(server, tokens);
     } else if (directive == config::section::error_page) {
       parseErrorPage(server, tokens);
+    } else if (directive == config::section::cgi_timeout) {
+      parseCgiTimeout(server, tokens);
     }
     else if (directive == config::section::location) {
       parseLocationBlock(server, ss, line, tokens);
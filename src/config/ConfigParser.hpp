@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "GlobalConfig.hpp"
 #include "ServerConfig.hpp"
 
 /**
@@ -29,6 +30,7 @@ class ConfigParser {
   const std::string& getConfigFilePath() const;
   size_t getServerCount() const;
   const std::vector<ServerConfig>& getServers() const;
+  const GlobalConfig& getGlobalConfig() const;
 
   void parse();
 
@@ -48,6 +50,7 @@ class ConfigParser {
   void splitContentIntoServerBlocks(const std::string& content,
                                     const std::string& typeOfExtraction);
   // Parsing logic
+  void parseGlobalDirectives(const std::string& content);
   void parseAllServerBlocks();
   ServerConfig parseSingleServerBlock(const std::string& blockContent);
 
@@ -62,6 +65,22 @@ class ConfigParser {
   void parseMaxSizeBody(ServerConfig& server,
                         const std::vector<std::string>& tokens);
   void parseErrorPage(ServerConfig& server, std::vector<std::string>& tokens);
+  void parseCgiTimeout(ServerConfig& server,
+                       const std::vector<std::string>& tokens);
+
+  // Directive parsers (global level)
+  void parseWorkerThreads(const std::vector<std::string>& tokens);
+  void parseWorkerProcesses(const std::vector<std::string>& tokens);
+  void parseEdgeTriggered(const std::vector<std::string>& tokens);
+  void parseEventBackend(const std::vector<std::string>& tokens);
+  void parseMaxConnections(const std::vector<std::string>& tokens);
+  void parseClientTimeout(const std::vector<std::string>& tokens);
+  void parsePhaseTimeout(const std::vector<std::string>& tokens);
+  void parseClientBodyMinRate(const std::vector<std::string>& tokens);
+  void parseClientBodyBufferSize(const std::vector<std::string>& tokens);
+  void parseLargeClientHeaderBuffers(const std::vector<std::string>& tokens);
+  void parseClientMaxHeaderCount(const std::vector<std::string>& tokens);
+  void parsePipelineDepth(const std::vector<std::string>& tokens);
 
   // Location & bonus parsers
   void parseLocationBlock(ServerConfig& server, std::stringstream& ss,
@@ -87,6 +106,7 @@ class ConfigParser {
   size_t servers_count_;
   std::vector<std::string> raw_server_blocks_;
   std::vector<ServerConfig> servers_;
+  GlobalConfig global_;
 };
 
 #endif  // WEBSERV_CONFIGPARSER_HPP
@@ -0,0 +1,29 @@
+#include "ConfigSnapshot.hpp"
+
+#include "ConfigParser.hpp"
+
+ConfigSnapshot::ConfigSnapshot(const std::vector<ServerConfig>& servers,
+                               const GlobalConfig& global)
+    : refs_(1), servers_(servers), global_(global) {}
+
+ConfigSnapshot::~ConfigSnapshot() {}
+
+ConfigSnapshot* ConfigSnapshot::load(const std::string& path) {
+  ConfigParser parser(path);
+  parser.parse();
+  return new ConfigSnapshot(parser.getServers(), parser.getGlobalConfig());
+}
+
+void ConfigSnapshot::acquire() { __sync_add_and_fetch(&refs_, 1); }
+
+void ConfigSnapshot::release() {
+  if (__sync_sub_and_fetch(&refs_, 1) == 0) delete this;
+}
+
+const std::vector<ServerConfig>& ConfigSnapshot::getServers() const {
+  return servers_;
+}
+
+const GlobalConfig& ConfigSnapshot::getGlobalConfig() const {
+  return global_;
+}
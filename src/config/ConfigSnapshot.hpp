@@ -0,0 +1,49 @@
+#ifndef WEBSERV_CONFIGSNAPSHOT_HPP
+#define WEBSERV_CONFIGSNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+
+#include "GlobalConfig.hpp"
+#include "ServerConfig.hpp"
+
+/**
+ * @brief Immutable, reference counted result of one parse of the config
+ * file.
+ *
+ * Every Client pins the snapshot it was accepted under, so a SIGHUP reload
+ * can hand a new snapshot to new connections while the old
+ * ServerConfig/LocationConfig objects stay alive until the last connection
+ * using them is closed.
+ *
+ * The count is atomic: reactors of different threads acquire and release
+ * the same snapshot. A snapshot is created with one reference (owned by
+ * whoever called load()) and deletes itself when the count reaches zero.
+ */
+class ConfigSnapshot {
+ public:
+  ConfigSnapshot(const std::vector<ServerConfig>& servers,
+                 const GlobalConfig& global);
+
+  // Parses `path`; throws ConfigException like ConfigParser::parse()
+  static ConfigSnapshot* load(const std::string& path);
+
+  void acquire();
+  void release();
+
+  const std::vector<ServerConfig>& getServers() const;
+  const GlobalConfig& getGlobalConfig() const;
+
+ private:
+  ~ConfigSnapshot();
+
+  volatile int refs_;
+  const std::vector<ServerConfig> servers_;
+  const GlobalConfig global_;
+
+  // Disable copying
+  ConfigSnapshot(const ConfigSnapshot&);
+  ConfigSnapshot& operator=(const ConfigSnapshot&);
+};
+
+#endif  // WEBSERV_CONFIGSNAPSHOT_HPP
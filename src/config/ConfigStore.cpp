@@ -0,0 +1,51 @@
+#include "ConfigStore.hpp"
+
+#include <exception>
+#include <iostream>
+
+ConfigStore::ConfigStore(const std::string& path)
+    : path_(path),
+      current_(ConfigSnapshot::load(path)),
+      generation_(0),
+      handled_(0) {}
+
+ConfigStore::~ConfigStore() { current_->release(); }
+
+ConfigSnapshot* ConfigStore::acquire() {
+  ScopedLock lock(mutex_);
+  current_->acquire();
+  return current_;
+}
+
+unsigned ConfigStore::refresh(unsigned requested) {
+  ScopedLock lock(mutex_);
+  if (requested == handled_) return generation_;
+  handled_ = requested;
+
+  try {
+    ConfigSnapshot* next = ConfigSnapshot::load(path_);
+    warnRestartOnly(next->getGlobalConfig());
+    current_->release();  // still alive while connections pin it
+    current_ = next;
+    ++generation_;
+    std::cout << "Configuration reloaded from " << path_ << " (generation "
+              << generation_ << ")" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "Reload of " << path_ << " failed, keeping the running "
+              << "configuration: " << e.what() << std::endl;
+  }
+  return generation_;
+}
+
+const std::string& ConfigStore::getPath() const { return path_; }
+
+void ConfigStore::warnRestartOnly(const GlobalConfig& next) const {
+  const GlobalConfig& cur = current_->getGlobalConfig();
+  if (next.getWorkerThreads() != cur.getWorkerThreads() ||
+      next.getWorkerProcesses() != cur.getWorkerProcesses() ||
+      next.getEventBackend() != cur.getEventBackend() ||
+      next.isEdgeTriggered() != cur.isEdgeTriggered()) {
+    std::cerr << "Warning: worker_threads, worker_processes, event_backend "
+                 "and edge_triggered only change on restart" << std::endl;
+  }
+}
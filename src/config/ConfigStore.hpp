@@ -0,0 +1,53 @@
+#ifndef WEBSERV_CONFIGSTORE_HPP
+#define WEBSERV_CONFIGSTORE_HPP
+
+#include <string>
+
+#include "ConfigSnapshot.hpp"
+#include "../common/Mutex.hpp"
+
+/**
+ * @brief Current configuration of the process, reloadable on SIGHUP.
+ *
+ * The SIGHUP handler only bumps a counter. Reactors notice the counter
+ * changed and call refresh(): the first one re-parses the file (under the
+ * lock, so the file is parsed once however many reactors there are), the
+ * others find the new snapshot already in place.
+ *
+ * A file that does not parse is reported and the current snapshot is kept:
+ * a typo never takes a running server down.
+ *
+ * worker_threads, worker_processes, event_backend and edge_triggered shape
+ * the process itself and still need a restart; a reload only warns when
+ * they change.
+ */
+class ConfigStore {
+ public:
+  // Parses `path`; throws ConfigException like ConfigParser::parse()
+  explicit ConfigStore(const std::string& path);
+  ~ConfigStore();
+
+  // Current snapshot with one more reference (caller must release() it)
+  ConfigSnapshot* acquire();
+
+  // Re-parses the file if `requested` (the SIGHUP count) has not been
+  // handled yet. Returns the generation, bumped on every successful reload.
+  unsigned refresh(unsigned requested);
+
+  const std::string& getPath() const;
+
+ private:
+  std::string path_;
+  ConfigSnapshot* current_;
+  unsigned generation_;
+  unsigned handled_;  // last SIGHUP count already processed
+  Mutex mutex_;
+
+  void warnRestartOnly(const GlobalConfig& next) const;
+
+  // Disable copying
+  ConfigStore(const ConfigStore&);
+  ConfigStore& operator=(const ConfigStore&);
+};
+
+#endif  // WEBSERV_CONFIGSTORE_HPP
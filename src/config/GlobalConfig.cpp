@@ -0,0 +1,222 @@
+#include "GlobalConfig.hpp"
+
+#include "../common/namespaces.hpp"
+#include "ConfigException.hpp"
+
+GlobalConfig::GlobalConfig()
+    : worker_threads_(config::section::default_worker_threads),
+      worker_processes_(config::section::default_worker_processes),
+      edge_triggered_(false),
+      event_backend_(config::section::backend_epoll),
+      max_connections_(config::section::default_max_connections),
+      client_timeout_(config::section::default_client_timeout),
+      client_header_timeout_(0),
+      client_body_timeout_(0),
+      keepalive_timeout_(0),
+      send_timeout_(0),
+      client_body_min_rate_(0),
+      client_body_buffer_size_(
+          config::section::default_client_body_buffer_size),
+      client_header_buffers_(config::section::default_header_buffers),
+      client_header_buffer_size_(
+          config::section::default_header_buffer_size),
+      client_max_header_count_(config::section::default_max_header_count),
+      pipeline_depth_(config::section::default_pipeline_depth) {}
+
+GlobalConfig::GlobalConfig(const GlobalConfig& other)
+    : worker_threads_(other.worker_threads_),
+      worker_processes_(other.worker_processes_),
+      edge_triggered_(other.edge_triggered_),
+      event_backend_(other.event_backend_),
+      max_connections_(other.max_connections_),
+      client_timeout_(other.client_timeout_),
+      client_header_timeout_(other.client_header_timeout_),
+      client_body_timeout_(other.client_body_timeout_),
+      keepalive_timeout_(other.keepalive_timeout_),
+      send_timeout_(other.send_timeout_),
+      client_body_min_rate_(other.client_body_min_rate_),
+      client_body_buffer_size_(other.client_body_buffer_size_),
+      client_header_buffers_(other.client_header_buffers_),
+      client_header_buffer_size_(other.client_header_buffer_size_),
+      client_max_header_count_(other.client_max_header_count_),
+      pipeline_depth_(other.pipeline_depth_) {}
+
+GlobalConfig& GlobalConfig::operator=(const GlobalConfig& other) {
+  if (this != &other) {
+    worker_threads_ = other.worker_threads_;
+    worker_processes_ = other.worker_processes_;
+    edge_triggered_ = other.edge_triggered_;
+    event_backend_ = other.event_backend_;
+    max_connections_ = other.max_connections_;
+    client_timeout_ = other.client_timeout_;
+    client_header_timeout_ = other.client_header_timeout_;
+    client_body_timeout_ = other.client_body_timeout_;
+    keepalive_timeout_ = other.keepalive_timeout_;
+    send_timeout_ = other.send_timeout_;
+    client_body_min_rate_ = other.client_body_min_rate_;
+    client_body_buffer_size_ = other.client_body_buffer_size_;
+    client_header_buffers_ = other.client_header_buffers_;
+    client_header_buffer_size_ = other.client_header_buffer_size_;
+    client_max_header_count_ = other.client_max_header_count_;
+    pipeline_depth_ = other.pipeline_depth_;
+  }
+  return *this;
+}
+
+GlobalConfig::~GlobalConfig() {}
+
+//	SETTERS
+void GlobalConfig::setWorkerThreads(int threads) {
+  if (threads < 1 || threads > config::section::max_worker_threads) {
+    throw ConfigException(config::errors::invalid_worker_threads);
+  }
+  worker_threads_ = threads;
+}
+
+void GlobalConfig::setWorkerProcesses(int processes) {
+  if (processes < 1 || processes > config::section::max_worker_processes) {
+    throw ConfigException(config::errors::invalid_worker_processes);
+  }
+  worker_processes_ = processes;
+}
+
+void GlobalConfig::setEdgeTriggered(bool enabled) { edge_triggered_ = enabled; }
+
+void GlobalConfig::setEventBackend(const std::string& backend) {
+  if (backend != config::section::backend_epoll &&
+      backend != config::section::backend_io_uring) {
+    throw ConfigException(config::errors::invalid_event_backend);
+  }
+  event_backend_ = backend;
+}
+
+void GlobalConfig::setMaxConnections(int connections) {
+  if (connections < 1 ||
+      connections > config::section::max_max_connections) {
+    throw ConfigException(config::errors::invalid_max_connections);
+  }
+  max_connections_ = connections;
+}
+
+void GlobalConfig::setClientTimeout(int seconds) {
+  if (seconds < 1 || seconds > config::section::max_timeout_seconds) {
+    throw ConfigException(config::errors::invalid_timeout +
+                          config::section::client_timeout);
+  }
+  client_timeout_ = seconds;
+}
+
+static void validateTimeout(int seconds, const std::string& directive) {
+  if (seconds < 1 || seconds > config::section::max_timeout_seconds) {
+    throw ConfigException(config::errors::invalid_timeout + directive);
+  }
+}
+
+void GlobalConfig::setClientHeaderTimeout(int seconds) {
+  validateTimeout(seconds, config::section::client_header_timeout);
+  client_header_timeout_ = seconds;
+}
+
+void GlobalConfig::setClientBodyTimeout(int seconds) {
+  validateTimeout(seconds, config::section::client_body_timeout);
+  client_body_timeout_ = seconds;
+}
+
+void GlobalConfig::setKeepaliveTimeout(int seconds) {
+  validateTimeout(seconds, config::section::keepalive_timeout);
+  keepalive_timeout_ = seconds;
+}
+
+void GlobalConfig::setSendTimeout(int seconds) {
+  validateTimeout(seconds, config::section::send_timeout);
+  send_timeout_ = seconds;
+}
+
+void GlobalConfig::setClientBodyMinRate(long bytesPerSecond) {
+  if (bytesPerSecond < 0) {
+    throw ConfigException(config::errors::invalid_min_rate);
+  }
+  client_body_min_rate_ = bytesPerSecond;
+}
+
+void GlobalConfig::setClientBodyBufferSize(long bytes) {
+  if (bytes < 1) {
+    throw ConfigException(config::errors::invalid_body_buffer_size);
+  }
+  client_body_buffer_size_ = bytes;
+}
+
+void GlobalConfig::setLargeClientHeaderBuffers(int number, long size) {
+  if (number < 1 || size < 1) {
+    throw ConfigException(config::errors::invalid_header_buffers);
+  }
+  client_header_buffers_ = number;
+  client_header_buffer_size_ = size;
+}
+
+void GlobalConfig::setClientMaxHeaderCount(int count) {
+  if (count < 1) {
+    throw ConfigException(config::errors::invalid_max_header_count);
+  }
+  client_max_header_count_ = count;
+}
+
+void GlobalConfig::setPipelineDepth(int depth) {
+  if (depth < 1 || depth > config::section::max_pipeline_depth) {
+    throw ConfigException(config::errors::invalid_pipeline_depth);
+  }
+  pipeline_depth_ = depth;
+}
+
+//	GETTERS
+int GlobalConfig::getWorkerThreads() const { return worker_threads_; }
+
+int GlobalConfig::getWorkerProcesses() const { return worker_processes_; }
+
+bool GlobalConfig::isEdgeTriggered() const { return edge_triggered_; }
+
+const std::string& GlobalConfig::getEventBackend() const {
+  return event_backend_;
+}
+
+int GlobalConfig::getMaxConnections() const { return max_connections_; }
+
+int GlobalConfig::getClientTimeout() const { return client_timeout_; }
+
+int GlobalConfig::getClientHeaderTimeout() const {
+  return client_header_timeout_ ? client_header_timeout_ : client_timeout_;
+}
+
+int GlobalConfig::getClientBodyTimeout() const {
+  return client_body_timeout_ ? client_body_timeout_ : client_timeout_;
+}
+
+int GlobalConfig::getKeepaliveTimeout() const {
+  return keepalive_timeout_ ? keepalive_timeout_ : client_timeout_;
+}
+
+int GlobalConfig::getSendTimeout() const {
+  return send_timeout_ ? send_timeout_ : client_timeout_;
+}
+
+long GlobalConfig::getClientBodyMinRate() const {
+  return client_body_min_rate_;
+}
+
+long GlobalConfig::getClientBodyBufferSize() const {
+  return client_body_buffer_size_;
+}
+
+long GlobalConfig::getClientHeaderBufferSize() const {
+  return client_header_buffer_size_;
+}
+
+long GlobalConfig::getClientHeaderMaxSize() const {
+  return client_header_buffers_ * client_header_buffer_size_;
+}
+
+int GlobalConfig::getClientMaxHeaderCount() const {
+  return client_max_header_count_;
+}
+
+int GlobalConfig::getPipelineDepth() const { return pipeline_depth_; }
@@ -0,0 +1,94 @@
+#ifndef WEBSERV_GLOBALCONFIG_HPP
+#define WEBSERV_GLOBALCONFIG_HPP
+
+#include <string>
+
+/**
+ * @brief Configuration of the directives that live outside every server { }
+ * block (nginx "main" context).
+ *
+ * Example equivalent configuration:
+ * ```
+ * worker_processes  2;
+ * worker_threads  4;
+ * edge_triggered  on;
+ * event_backend  io_uring;
+ * max_connections  1024;
+ * client_timeout  60s;
+ * client_header_timeout  10s;
+ * client_body_timeout  30s;
+ * keepalive_timeout  15s;
+ * send_timeout  30s;
+ * client_body_min_rate  1k;
+ * client_body_buffer_size  16k;
+ * large_client_header_buffers  4 8k;
+ * client_max_header_count  100;
+ * pipeline_depth  32;
+ * server { ... }
+ * ```
+ */
+class GlobalConfig {
+ public:
+  GlobalConfig();
+  GlobalConfig(const GlobalConfig& other);
+  GlobalConfig& operator=(const GlobalConfig& other);
+  ~GlobalConfig();
+
+  // Setters
+  void setWorkerThreads(int threads);
+  void setWorkerProcesses(int processes);
+  void setEdgeTriggered(bool enabled);
+  void setEventBackend(const std::string& backend);
+  void setMaxConnections(int connections);
+  void setClientTimeout(int seconds);
+  void setClientHeaderTimeout(int seconds);
+  void setClientBodyTimeout(int seconds);
+  void setKeepaliveTimeout(int seconds);
+  void setSendTimeout(int seconds);
+  void setClientBodyMinRate(long bytesPerSecond);
+  void setClientBodyBufferSize(long bytes);
+  void setLargeClientHeaderBuffers(int number, long size);
+  void setClientMaxHeaderCount(int count);
+  void setPipelineDepth(int depth);
+
+  // Getters
+  int getWorkerThreads() const;
+  int getWorkerProcesses() const;
+  bool isEdgeTriggered() const;
+  const std::string& getEventBackend() const;
+  int getMaxConnections() const;
+  int getClientTimeout() const;
+  // Per-phase timeouts: client_timeout unless set explicitly
+  int getClientHeaderTimeout() const;
+  int getClientBodyTimeout() const;
+  int getKeepaliveTimeout() const;
+  int getSendTimeout() const;
+  long getClientBodyMinRate() const;
+  long getClientBodyBufferSize() const;
+  // Request line and each header line: at most one buffer. The whole head:
+  // at most number * size bytes.
+  long getClientHeaderBufferSize() const;
+  long getClientHeaderMaxSize() const;
+  int getClientMaxHeaderCount() const;
+  int getPipelineDepth() const;
+
+ private:
+  int worker_threads_;
+  int worker_processes_;
+  bool edge_triggered_;
+  std::string event_backend_;  // "epoll" | "io_uring"
+  int max_connections_;        // open clients per reactor
+  int client_timeout_;  // seconds without socket activity
+  int client_header_timeout_;  // 0 = client_timeout_
+  int client_body_timeout_;    // 0 = client_timeout_
+  int keepalive_timeout_;      // 0 = client_timeout_
+  int send_timeout_;           // 0 = client_timeout_
+  long client_body_min_rate_;  // bytes/s, 0 = no minimum
+  long client_body_buffer_size_;  // larger bodies go to a temp file
+  int client_header_buffers_;       // large_client_header_buffers number
+  long client_header_buffer_size_;  // large_client_header_buffers size
+  int client_max_header_count_;
+  int pipeline_depth_;  // unsent responses before a client stops being read
+};
+
+#endif  // WEBSERV_GLOBALCONFIG_HPP
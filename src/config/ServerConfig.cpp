@@ -16,6 +16,7 @@ ServerConfig::ServerConfig()
 
 ServerConfig::ServerConfig(const ServerConfig& other)
     : listen_port_(other.listen_port_),
+      listen_options_(other.listen_options_),
       host_address_(other.host_address_),
       server_name_(other.server_name_),
       root_(other.root_),
@@ -31,6 +32,7 @@ ServerConfig::ServerConfig(const ServerConfig& other)
 ServerConfig& ServerConfig::operator=(const ServerConfig& other) {
   if (this != &other) {
     listen_port_ = other.listen_port_;
+    listen_options_ = other.listen_options_;
     host_address_ = other.host_address_;
     root_ = other.root_;
     indexes_ = other.indexes_;
@@ -56,6 +58,10 @@ void ServerConfig::setPort(int port) {
   listen_port_ = port;
 }
 
+void ServerConfig::setListenOptions(const ListenOptions& options) {
+  listen_options_ = options;
+}
+
 void ServerConfig::setHost(const std::string& host) { host_address_ = host; }
 
 void ServerConfig::setServerName(const std::string& name) {
@@ -106,6 +112,10 @@ void ServerConfig::setRedirectUrl(const std::string& url) {
 
 int ServerConfig::getPort() const { return listen_port_; }
 
+const ListenOptions& ServerConfig::getListenOptions() const {
+  return listen_options_;
+}
+
 const std::string& ServerConfig::getHost() const { return host_address_; }
 
 const std::string& ServerConfig::getServerName() const { return server_name_; }
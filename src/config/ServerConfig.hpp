@@ -9,6 +9,35 @@
 #include "LocationConfig.hpp"
 #include "common/namespaces.hpp"
 
+/**
+ * @brief Socket tuning given as extra parameters of `listen`
+ *
+ * ```
+ * listen 8080 deferred fastopen=256 rcvbuf=64k sndbuf=256k notsent_lowat=16k;
+ * ```
+ * 0 leaves the kernel default untouched. They belong to the listening
+ * socket, so with several servers on one port the first one's options win.
+ */
+struct ListenOptions {
+  int defer_accept;   // TCP_DEFER_ACCEPT seconds (`deferred`)
+  int fastopen;       // TCP_FASTOPEN pending SYN queue length
+  int rcvbuf;         // SO_RCVBUF bytes
+  int sndbuf;         // SO_SNDBUF bytes
+  int notsent_lowat;  // TCP_NOTSENT_LOWAT bytes
+
+  ListenOptions()
+      : defer_accept(0), fastopen(0), rcvbuf(0), sndbuf(0), notsent_lowat(0) {}
+
+  bool operator==(const ListenOptions& other) const {
+    return defer_accept == other.defer_accept && fastopen == other.fastopen &&
+           rcvbuf == other.rcvbuf && sndbuf == other.sndbuf &&
+           notsent_lowat == other.notsent_lowat;
+  }
+  bool operator!=(const ListenOptions& other) const {
+    return !(*this == other);
+  }
+};
+
 /**
  * @brief Configuration of one server { } block
  * Represents a virtual server (nginx-like style).
@@ -16,7 +45,7 @@
  * Example equivalent configuration:
  * ```
  * server {
- *     listen          8080;
+ *     listen          8080 deferred;
  *     host            127.0.0.1;
  *     server_name     example.com;
  *     root            /var/www/html;
@@ -41,6 +70,7 @@ class ServerConfig {
 
   // Setters
   void setPort(int port);
+  void setListenOptions(const ListenOptions& options);
   void setHost(const std::string& host);
   void setServerName(const std::string& name);
   void setRoot(const std::string& root);
@@ -55,6 +85,7 @@ class ServerConfig {
 
   // Getters
   int getPort() const;
+  const ListenOptions& getListenOptions() const;
   const std::string& getHost() const;
   const std::string& getServerName() const;
   const std::string& getRoot() const;
@@ -73,6 +104,7 @@ class ServerConfig {
 
  private:
   int listen_port_;
+  ListenOptions listen_options_;
   std::string host_address_;
   std::string server_name_;
   std::string root_;
@@ -0,0 +1,97 @@
+#include "FormUpload.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+#include "RequestBody.hpp"
+
+FormUpload::FormUpload(const std::string& dir, const std::string& boundary)
+    : dir_(dir), parser_(boundary, *this), files_(), fd_(-1) {
+  if (dir_.empty() || dir_[dir_.size() - 1] != '/') dir_ += '/';
+}
+
+FormUpload::~FormUpload() {
+  if (fd_ >= 0) close(fd_);
+  removeTemps();
+}
+
+bool FormUpload::write(const char* data, std::size_t len) {
+  return parser_.feed(data, len);
+}
+
+bool FormUpload::isComplete() const {
+  return parser_.isDone() && !parser_.hasError();
+}
+
+std::size_t FormUpload::fileCount() const { return files_.size(); }
+
+bool FormUpload::commit() {
+  if (!isComplete()) return false;
+  for (std::size_t i = 0; i < files_.size(); ++i) {
+    if (rename(files_[i].tempPath.c_str(), files_[i].finalPath.c_str()) != 0)
+      return false;  // el destructor borra los que quedan
+    files_[i].tempPath.clear();
+  }
+  return true;
+}
+
+// Solo el último componente del nombre que manda el navegador: nunca se
+// escribe fuera de upload_store
+std::string FormUpload::targetName(const std::string& filename) const {
+  std::string name = filename.substr(filename.find_last_of("/\\") + 1);
+  bool valid = !name.empty() && name != "." && name != "..";
+  for (std::size_t i = 0; valid && i < name.size(); ++i) {
+    if (static_cast<unsigned char>(name[i]) < 0x20 || name[i] == 0x7f)
+      valid = false;
+  }
+  if (valid) return name;
+
+  std::ostringstream oss;
+  oss << "uploaded_file_" << std::time(NULL) << "_" << files_.size();
+  return oss.str();
+}
+
+bool FormUpload::onPartBegin(const MultipartPart& part) {
+  if (!part.hasFilename) return true;  // campo de texto: se descarta
+
+  File file;
+  fd_ = RequestBody::createUploadFile(dir_, file.tempPath);
+  if (fd_ < 0) return false;
+
+  file.finalPath = dir_ + targetName(part.filename);
+  files_.push_back(file);
+  return true;
+}
+
+bool FormUpload::onPartData(const char* data, std::size_t len) {
+  if (fd_ < 0) return true;
+  while (len > 0) {
+    ssize_t n = ::write(fd_, data, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += n;
+    len -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+bool FormUpload::onPartEnd() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  return true;
+}
+
+void FormUpload::removeTemps() {
+  for (std::size_t i = 0; i < files_.size(); ++i) {
+    if (!files_[i].tempPath.empty()) unlink(files_[i].tempPath.c_str());
+  }
+  files_.clear();
+}
@@ -0,0 +1,58 @@
+#ifndef FORM_UPLOAD_HPP
+#define FORM_UPLOAD_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MultipartParser.hpp"
+
+/**
+ * @brief Upload de un formulario (multipart/form-data) a upload_store.
+ *
+ * Cada parte con filename se escribe, según llega, en su propio temporal
+ * (.upload-XXXXXX) dentro del directorio; los campos sin filename se
+ * descartan. Nada se guarda entero en memoria.
+ *
+ * commit() renombra todos los temporales a su nombre (el basename del
+ * filename del cliente) cuando la petición terminó bien; si no se llama,
+ * el destructor los borra.
+ */
+class FormUpload : public MultipartHandler {
+ public:
+  FormUpload(const std::string& dir, const std::string& boundary);
+  ~FormUpload();
+
+  // false si no se pudo escribir en disco
+  bool write(const char* data, std::size_t len);
+
+  // El body terminó con "--boundary--" y estaba bien formado
+  bool isComplete() const;
+  std::size_t fileCount() const;
+  // false si algún rename() falló (los temporales que quedan se borran)
+  bool commit();
+
+  // MultipartHandler
+  bool onPartBegin(const MultipartPart& part);
+  bool onPartData(const char* data, std::size_t len);
+  bool onPartEnd();
+
+ private:
+  struct File {
+    std::string tempPath;
+    std::string finalPath;
+  };
+
+  std::string dir_;  // con '/' final
+  MultipartParser parser_;
+  std::vector<File> files_;
+  int fd_;  // parte (fichero) en curso, -1 si no hay o es un campo
+
+  std::string targetName(const std::string& filename) const;
+  void removeTemps();
+
+  FormUpload(const FormUpload&);
+  FormUpload& operator=(const FormUpload&);
+};
+
+#endif  // FORM_UPLOAD_HPP
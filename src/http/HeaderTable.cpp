@@ -0,0 +1,172 @@
+#include "HeaderTable.hpp"
+
+#include <cctype>
+
+#include "HttpHeaderUtils.hpp"
+
+namespace {
+
+// Mismo orden que HttpHeaderId
+const char* const kNames[HTTP_HEADER_COUNT] = {
+    "host",          "connection",        "content-length",
+    "content-type",  "transfer-encoding", "expect",
+    "cookie",        "set-cookie",        "if-none-match",
+    "if-modified-since", "range",         "location",
+    "user-agent",    "accept",            "accept-encoding",
+    "accept-language", "referer",         "authorization",
+    "cache-control", "keep-alive",        "upgrade",
+    "origin",        "etag",              "last-modified",
+    "date",          "server",            "content-range",
+    "accept-ranges", "x-forwarded-for"};
+
+// Hash perfecto para kNames: longitud, primera y última letra. Las
+// constantes están elegidas para que los 29 nombres caigan en huecos
+// distintos de 64; añadir un nombre puede obligar a buscar otras.
+const std::size_t HASH_SIZE = 64;
+
+std::size_t hashName(const char* name, std::size_t len) {
+  std::size_t first = std::tolower(static_cast<unsigned char>(name[0]));
+  std::size_t last = std::tolower(static_cast<unsigned char>(name[len - 1]));
+  return (len * 34 + first + last * 53) & (HASH_SIZE - 1);
+}
+
+struct Names {
+  std::string lower[HTTP_HEADER_COUNT];
+  HttpHeaderId byHash[HASH_SIZE];
+
+  Names() {
+    for (std::size_t h = 0; h < HASH_SIZE; ++h) byHash[h] = HTTP_HEADER_OTHER;
+    for (int id = 0; id < HTTP_HEADER_COUNT; ++id) {
+      lower[id] = kNames[id];
+      byHash[hashName(lower[id].data(), lower[id].size())] =
+          static_cast<HttpHeaderId>(id);
+    }
+  }
+};
+
+const Names& names() {
+  static const Names instance;
+  return instance;
+}
+
+}  // namespace
+
+HeaderTable::HeaderTable() : fields_(), used_(0) {
+  for (int id = 0; id < HTTP_HEADER_COUNT; ++id) slots_[id] = -1;
+}
+
+HeaderTable::HeaderTable(const HeaderTable& other) : fields_(), used_(0) {
+  for (int id = 0; id < HTTP_HEADER_COUNT; ++id) slots_[id] = -1;
+  *this = other;
+}
+
+HeaderTable& HeaderTable::operator=(const HeaderTable& other) {
+  if (this == &other) return *this;
+  if (fields_.size() < other.used_) fields_.resize(other.used_);
+  for (std::size_t i = 0; i < other.used_; ++i) {
+    fields_[i].id = other.fields_[i].id;
+    fields_[i].name = other.fields_[i].name;
+    fields_[i].value = other.fields_[i].value;
+  }
+  used_ = other.used_;
+  for (int id = 0; id < HTTP_HEADER_COUNT; ++id) slots_[id] = other.slots_[id];
+  return *this;
+}
+
+HeaderTable::~HeaderTable() {}
+
+HttpHeaderId HeaderTable::lookup(const char* name, std::size_t len) {
+  if (len == 0) return HTTP_HEADER_OTHER;
+  HttpHeaderId id = names().byHash[hashName(name, len)];
+  if (id == HTTP_HEADER_OTHER) return id;
+
+  const std::string& candidate = names().lower[id];
+  if (candidate.size() != len ||
+      !http_header_utils::equalsIgnoreCase(name, len, candidate.c_str()))
+    return HTTP_HEADER_OTHER;
+  return id;
+}
+
+const std::string& HeaderTable::nameOf(HttpHeaderId id) {
+  return names().lower[id];
+}
+
+HeaderTable::Field& HeaderTable::append(HttpHeaderId id) {
+  if (used_ == fields_.size()) fields_.push_back(Field());
+  Field& field = fields_[used_++];
+  field.id = id;
+  field.name.clear();
+  return field;
+}
+
+int HeaderTable::findOther(const char* name, std::size_t len) const {
+  for (std::size_t i = 0; i < used_; ++i) {
+    const Field& field = fields_[i];
+    if (field.id == HTTP_HEADER_OTHER && field.name.size() == len &&
+        http_header_utils::equalsIgnoreCase(name, len, field.name.c_str()))
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void HeaderTable::set(HttpHeaderId id, const char* value, std::size_t len) {
+  if (slots_[id] < 0) {
+    slots_[id] = static_cast<int>(used_);
+    append(id);
+  }
+  fields_[slots_[id]].value.assign(value, len);
+}
+
+void HeaderTable::set(const char* name, std::size_t nameLen,
+                      const char* value, std::size_t valueLen) {
+  HttpHeaderId id = lookup(name, nameLen);
+  if (id != HTTP_HEADER_OTHER) {
+    set(id, value, valueLen);
+    return;
+  }
+
+  int index = findOther(name, nameLen);
+  if (index < 0) {
+    index = static_cast<int>(used_);
+    Field& field = append(HTTP_HEADER_OTHER);
+    field.name.assign(name, nameLen);
+    for (std::size_t i = 0; i < nameLen; ++i)
+      field.name[i] = std::tolower(static_cast<unsigned char>(name[i]));
+  }
+  fields_[index].value.assign(value, valueLen);
+}
+
+void HeaderTable::set(const std::string& name, const std::string& value) {
+  set(name.data(), name.size(), value.data(), value.size());
+}
+
+const std::string* HeaderTable::find(HttpHeaderId id) const {
+  if (id == HTTP_HEADER_OTHER || slots_[id] < 0) return NULL;
+  return &fields_[slots_[id]].value;
+}
+
+const std::string* HeaderTable::find(const std::string& name) const {
+  HttpHeaderId id = lookup(name.data(), name.size());
+  if (id != HTTP_HEADER_OTHER) return find(id);
+
+  int index = findOther(name.data(), name.size());
+  return index < 0 ? NULL : &fields_[index].value;
+}
+
+std::size_t HeaderTable::size() const { return used_; }
+
+const std::string& HeaderTable::nameAt(std::size_t i) const {
+  const Field& field = fields_[i];
+  return field.id == HTTP_HEADER_OTHER ? field.name : nameOf(field.id);
+}
+
+const std::string& HeaderTable::valueAt(std::size_t i) const {
+  return fields_[i].value;
+}
+
+HttpHeaderId HeaderTable::idAt(std::size_t i) const { return fields_[i].id; }
+
+void HeaderTable::clear() {
+  for (int id = 0; id < HTTP_HEADER_COUNT; ++id) slots_[id] = -1;
+  used_ = 0;
+}
@@ -0,0 +1,101 @@
+#ifndef HEADER_TABLE_HPP
+#define HEADER_TABLE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Headers conocidos: los que el servidor consulta (o que casi todos los
+// clientes mandan) tienen un id y un hueco fijo en HeaderTable.
+enum HttpHeaderId {
+  HTTP_HEADER_HOST,
+  HTTP_HEADER_CONNECTION,
+  HTTP_HEADER_CONTENT_LENGTH,
+  HTTP_HEADER_CONTENT_TYPE,
+  HTTP_HEADER_TRANSFER_ENCODING,
+  HTTP_HEADER_EXPECT,
+  HTTP_HEADER_COOKIE,
+  HTTP_HEADER_SET_COOKIE,
+  HTTP_HEADER_IF_NONE_MATCH,
+  HTTP_HEADER_IF_MODIFIED_SINCE,
+  HTTP_HEADER_RANGE,
+  HTTP_HEADER_LOCATION,
+  HTTP_HEADER_USER_AGENT,
+  HTTP_HEADER_ACCEPT,
+  HTTP_HEADER_ACCEPT_ENCODING,
+  HTTP_HEADER_ACCEPT_LANGUAGE,
+  HTTP_HEADER_REFERER,
+  HTTP_HEADER_AUTHORIZATION,
+  HTTP_HEADER_CACHE_CONTROL,
+  HTTP_HEADER_KEEP_ALIVE,
+  HTTP_HEADER_UPGRADE,
+  HTTP_HEADER_ORIGIN,
+  HTTP_HEADER_ETAG,
+  HTTP_HEADER_LAST_MODIFIED,
+  HTTP_HEADER_DATE,
+  HTTP_HEADER_SERVER,
+  HTTP_HEADER_CONTENT_RANGE,
+  HTTP_HEADER_ACCEPT_RANGES,
+  HTTP_HEADER_X_FORWARDED_FOR,
+  HTTP_HEADER_COUNT,
+  HTTP_HEADER_OTHER = HTTP_HEADER_COUNT  // cualquier otro nombre
+};
+
+/**
+ * @brief Headers de una petición o respuesta, sin std::map.
+ *
+ * - Conocidos: el nombre se resuelve con un hash perfecto (una búsqueda en
+ *   una tabla de 64 + una comparación) y el header vive en un hueco fijo:
+ *   get(HTTP_HEADER_HOST) es O(1), sin pasar el nombre a minúsculas.
+ * - El resto va en un vector plano y se busca recorriéndolo (son pocos).
+ * - Los nombres se guardan en minúsculas; un nombre repetido sobrescribe el
+ *   valor anterior. Se recorren en orden de llegada (at(i)).
+ * - clear() no libera nada: los strings se reutilizan en la siguiente
+ *   petición keep-alive.
+ */
+class HeaderTable {
+ public:
+  HeaderTable();
+  HeaderTable(const HeaderTable& other);
+  HeaderTable& operator=(const HeaderTable& other);
+  ~HeaderTable();
+
+  // Id de un nombre (sin distinguir mayúsculas), HTTP_HEADER_OTHER si no es
+  // uno de los conocidos
+  static HttpHeaderId lookup(const char* name, std::size_t len);
+  // Nombre en minúsculas de un header conocido
+  static const std::string& nameOf(HttpHeaderId id);
+
+  void set(HttpHeaderId id, const char* value, std::size_t len);
+  void set(const char* name, std::size_t nameLen, const char* value,
+           std::size_t valueLen);
+  void set(const std::string& name, const std::string& value);
+
+  // NULL si no está
+  const std::string* find(HttpHeaderId id) const;
+  const std::string* find(const std::string& name) const;
+
+  // Recorrido en orden de llegada
+  std::size_t size() const;
+  const std::string& nameAt(std::size_t i) const;
+  const std::string& valueAt(std::size_t i) const;
+  HttpHeaderId idAt(std::size_t i) const;
+
+  void clear();
+
+ private:
+  struct Field {
+    HttpHeaderId id;
+    std::string name;  // solo para HTTP_HEADER_OTHER
+    std::string value;
+  };
+
+  std::vector<Field> fields_;  // [0, used_) en uso, el resto para reutilizar
+  std::size_t used_;
+  int slots_[HTTP_HEADER_COUNT];  // índice en fields_, -1 si no está
+
+  Field& append(HttpHeaderId id);
+  int findOther(const char* name, std::size_t len) const;
+};
+
+#endif  // HEADER_TABLE_HPP
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 
 namespace http_header_utils {
 
@@ -27,4 +28,26 @@ bool splitHeaderLine(const std::string& line, std::string& key,
   return true;
 }
 
+bool equalsIgnoreCase(const char* data, std::size_t len, const char* lower) {
+  std::size_t i = 0;
+  for (; i < len && lower[i]; ++i) {
+    if (std::tolower(static_cast<unsigned char>(data[i])) != lower[i])
+      return false;
+  }
+  return i == len && lower[i] == '\0';
+}
+
+bool containsIgnoreCase(const char* data, std::size_t len, const char* lower) {
+  std::size_t n = std::strlen(lower);
+  if (n == 0) return true;
+  for (std::size_t i = 0; i + n <= len; ++i) {
+    std::size_t j = 0;
+    while (j < n &&
+           std::tolower(static_cast<unsigned char>(data[i + j])) == lower[j])
+      ++j;
+    if (j == n) return true;
+  }
+  return false;
+}
+
 }  // namespace http_header_utils
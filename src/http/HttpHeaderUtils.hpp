@@ -1,6 +1,7 @@
 #ifndef HTTP_HEADER_UTILS_HPP
 #define HTTP_HEADER_UTILS_HPP
 
+#include <cstddef>
 #include <string>
 
 namespace http_header_utils {
@@ -10,6 +11,10 @@ std::string toLowerCopy(const std::string& value);
 bool splitHeaderLine(const std::string& line, std::string& key,
                      std::string& value);
 
+// Sin copias, sobre [data, data + len): `lower` es un literal en minúsculas
+bool equalsIgnoreCase(const char* data, std::size_t len, const char* lower);
+bool containsIgnoreCase(const char* data, std::size_t len, const char* lower);
+
 }  // namespace http_header_utils
 
 #endif  // HTTP_HEADER_UTILS_HPP
@@ -1,6 +1,15 @@
 #include "HttpParser.hpp"
 
-HttpParser::HttpParser() : _maxBodySize(0), _errorStatusCode(400) { reset(); }
+HttpParser::HttpParser()
+    : _maxBodySize(0),
+      _bodyLimit(0),
+      _maxLineSize(0),
+      _maxHeadSize(0),
+      _maxHeaderCount(0),
+      _errorStatusCode(400),
+      _pauseAtBody(false) {
+  reset();
+}
 
 HttpParser::~HttpParser() {}
 
@@ -18,12 +27,16 @@ void HttpParser::reset() {
   _state = PARSING_START_LINE;
   _stateChunk = CHUNK_SIZE;
   _request.clear();
-  _chunkBuffer.clear();
+  _cursor = 0;
+  _scanPos = 0;
+  _fields.clear();
   _contentLength = 0;
   _isChunked = false;
   _bytesRead = 0;
   _chunkSize = 0;
   _errorStatusCode = 400;
+  _atBodyStart = false;
+  _bodyLimit = _maxBodySize;
   // _maxBodySize NO se resetea: se establece una vez en el constructor de
   // Client y debe persistir para que todas las peticiones Keep-Alive usen el
   // mismo límite.
@@ -34,8 +47,54 @@ void HttpParser::reset() {
  * @param data: Los datos recibidos del cliente.
  */
 void HttpParser::consume(const std::string& data) {
-  _buffer.append(data);
+  _buffer.append(data.data(), data.size());
+  parse();
+}
+
+void HttpParser::setBufferPool(BufferPool* pool) { _buffer.setPool(pool); }
+
+bool HttpParser::storeBodyIn(const std::string& dir) {
+  if (!_atBodyStart) return false;
+  // Sin límite el Content-Length no está acotado: no se reserva nada
+  bool preallocate = !_isChunked && _bodyLimit != 0;
+  return _request.storeBodyIn(dir, preallocate ? _contentLength : 0);
+}
+
+bool HttpParser::limitBody(std::size_t maxSize) {
+  if (!_atBodyStart) return false;
+  _bodyLimit = maxSize;
+  if (_isChunked || maxSize == 0 || _contentLength <= maxSize) return true;
+  _atBodyStart = false;
+  _errorStatusCode = 413;
+  _state = ERROR;
+  return false;
+}
+
+bool HttpParser::isBodyBuffered() const {
+  return _atBodyStart && !_isChunked && _buffer.size() >= _contentLength;
+}
+
+void HttpParser::startBody() {
+  if (!_atBodyStart) return;
+  _atBodyStart = false;
+  parse();
+}
+
+char* HttpParser::prepareRead(std::size_t hint, std::size_t& room) {
+  return _buffer.prepare(hint, room);
+}
+
+void HttpParser::commitRead(std::size_t bytes) {
+  _buffer.commit(bytes);
+  parse();
+}
 
+std::size_t HttpParser::bufferedBytes() const { return _buffer.size(); }
+
+void HttpParser::releaseIdleBuffer() { _buffer.release(); }
+
+// Avanza la maquina de estados con lo que haya en _buffer
+void HttpParser::parse() {
   while (true) {
     State prevState = _state;
 
@@ -47,7 +106,7 @@ void HttpParser::consume(const std::string& data) {
         parseHeaders();
         break;
       case PARSING_BODY:
-        parseBody();
+        if (!_atBodyStart) parseBody();
         break;
       default:
         break;
@@ -55,6 +114,11 @@ void HttpParser::consume(const std::string& data) {
 
     if (_state == ERROR) break;
 
+    if (_pauseAtBody && prevState != PARSING_BODY && _state == PARSING_BODY) {
+      _atBodyStart = true;  // el caller sigue con startBody()
+      break;
+    }
+
     if (_state == COMPLETE) {
       // Dejar la petición disponible para el caller.
       // El caller decide cuándo llamar a reset().
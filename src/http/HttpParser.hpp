@@ -3,8 +3,12 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include "HttpRequest.hpp"
+#include "common/RecvBuffer.hpp"
+
+class BufferPool;
 
 enum State {
   PARSING_START_LINE,
@@ -34,39 +38,112 @@ class HttpParser {
   int getErrorStatusCode() const;
 
   // Set max body size from config (client_max_body_size). Call before
-  // consume().
-  void setMaxBodySize(std::size_t maxSize) { _maxBodySize = maxSize; }
+  // consume(). Es el máximo de todo el server: cada petición lo puede bajar
+  // con limitBody().
+  void setMaxBodySize(std::size_t maxSize) {
+    _maxBodySize = maxSize;
+    _bodyLimit = maxSize;
+  }
+  // large_client_header_buffers / client_max_header_count (0 = sin límite):
+  // línea (start line o header), cabecera entera y número de headers. Se
+  // comprueban según llegan los bytes, sin esperar al final de la línea: 414
+  // para la start line, 431 para el resto. Persisten entre peticiones.
+  void setHeaderLimits(std::size_t lineSize, std::size_t headSize,
+                       std::size_t headerCount) {
+    _maxLineSize = lineSize;
+    _maxHeadSize = headSize;
+    _maxHeaderCount = headerCount;
+  }
+  // client_body_buffer_size: bodies mayores se guardan en un fichero
+  // temporal. Persiste entre peticiones keep-alive (reset() no lo toca).
+  void setBodyBufferSize(std::size_t bytes) {
+    _request.setBodyBufferSize(bytes);
+  }
+
+  // Con pauseAtBody el parser se detiene al acabar cada cabecera que lleva
+  // body, antes de leer un solo byte de él (isAtBodyStart()): el caller
+  // decide dónde guardarlo y sigue con startBody().
+  void setPauseAtBody(bool pause) { _pauseAtBody = pause; }
+  bool isAtBodyStart() const { return _atBodyStart; }
+  // Upload: el body va directo a un temporal en dir (reservando
+  // Content-Length). Solo en isAtBodyStart().
+  bool storeBodyIn(const std::string& dir);
+  // Límite de la location de esta petición (0 = sin límite), solo en
+  // isAtBodyStart(). Si el Content-Length ya lo supera pasa a ERROR (413)
+  // sin leer el body y devuelve false.
+  bool limitBody(std::size_t maxSize);
+  // El body entero (Content-Length) ya está en el buffer: leerlo no cuesta
+  // nada. Solo en isAtBodyStart().
+  bool isBodyBuffered() const;
+  void startBody();
+
+  // Lectura directa al buffer interno (sin copia intermedia): recv() escribe
+  // en prepareRead(), commitRead(n) procesa esos n bytes como consume().
+  void setBufferPool(BufferPool* pool);
+  char* prepareRead(std::size_t hint, std::size_t& room);
+  void commitRead(std::size_t bytes);
+  std::size_t bufferedBytes() const;
+  // Devuelve el buffer al pool si no queda nada pendiente (conexion idle)
+  void releaseIdleBuffer();
 
  private:
+  // Trozo del buffer de recepción: [offset, offset + len) desde
+  // _buffer.data(). Sigue siendo válido mientras no se haga consume(): el
+  // buffer puede compactarse o crecer, pero conserva las posiciones relativas.
+  struct Slice {
+    std::size_t offset;
+    std::size_t len;
+    Slice() : offset(0), len(0) {}
+  };
+  struct HeaderField {
+    Slice key;
+    Slice value;
+    HttpHeaderId id;  // HTTP_HEADER_OTHER si no es uno de los conocidos
+  };
+
   // Estado y datos internos
   State _state;
   StateChunk _stateChunk;
   HttpRequest _request;
-  std::string _buffer;       // acumulador interno para líneas/body pendientes
-  std::string _chunkBuffer;  // acumulador interno para cuerpos de chunked
+  RecvBuffer _buffer;  // bytes recibidos aun no procesados
+  // Cabecera en curso: se recorre con un cursor y no se consume del buffer
+  // hasta la línea vacía final (un solo consume() por petición)
+  std::size_t _cursor;   // inicio de la siguiente línea
+  std::size_t _scanPos;  // desde donde seguir buscando "\r\n"
+  std::vector<HeaderField> _fields;  // se reutiliza entre peticiones
   std::size_t _contentLength;
   bool _isChunked;
   std::size_t _bytesRead;
   std::size_t _chunkSize;    // tamaño del chunk actual
   std::size_t _maxBodySize;  // límite desde config; 0 = sin límite
+  std::size_t _bodyLimit;    // el de la petición en curso (limitBody())
+  std::size_t _maxLineSize;     // setHeaderLimits()
+  std::size_t _maxHeadSize;
+  std::size_t _maxHeaderCount;
   int _errorStatusCode;      // 400 por defecto; 403 para directory traversal
+  bool _pauseAtBody;
+  bool _atBodyStart;  // parado entre la cabecera y el body
 
   // Helpers generales
-  bool extractLine(std::string& line);
+  void parse();
+  bool nextLine(Slice& line);
+  void consumeLines();
+  const char* at(const Slice& slice) const;
+  bool checkHeadLimits(std::size_t lineLen, std::size_t headBytes);
 
   // Start line
-  bool splitStartLine(const std::string& line, std::string& method,
-                      std::string& uri, std::string& version);
-  void parseUri(const std::string& uri);
+  bool splitStartLine(const Slice& line, Slice& method, Slice& uri,
+                      Slice& version) const;
+  void parseUri(const char* uri, std::size_t len);
   void parseStartLine();
 
   // Headers
-  bool splitHeaderLine(const std::string& line, std::string& key,
-                       std::string& value);
-  void handleHeader(const std::string& key, const std::string& value);
-  bool processHeaderLine(const std::string& line);
+  bool splitHeaderLine(const Slice& line, HeaderField& field) const;
+  void handleHeader(const HeaderField& field);
+  bool processHeaderLine(const Slice& line);
   void parseHeaders();
   bool validateHeaders() const;
+  void commitHead();
 
   // Body
   bool parseChunkSizeLine(std::size_t& size);
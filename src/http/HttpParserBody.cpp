@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <cstdlib>
 #include <iostream>
 #include <vector>
 
@@ -20,10 +19,10 @@ void HttpParser::parseBody() {
  */
 void HttpParser::parseBodyFixedLength() {
   // Check si el tamano total esperado supera el límite.
-  if (_maxBodySize > 0 && _contentLength > _maxBodySize) {
+  if (_bodyLimit > 0 && _contentLength > _bodyLimit) {
 #ifdef DEBUG
     std::cerr << "[PARSER BODY LIMIT] Content-Length (" << _contentLength
-              << ") > Max (" << _maxBodySize << ") -> 413" << std::endl;
+              << ") > Max (" << _bodyLimit << ") -> 413" << std::endl;
 #endif
     _errorStatusCode = 413;
     _state = ERROR;
@@ -34,7 +33,7 @@ void HttpParser::parseBodyFixedLength() {
   if (_bytesRead == 0 && _contentLength > 0) {
     std::cerr << "[PARSER BODY START] Content-Length: " << _contentLength
               << " bytes, Max allowed: "
-              << (_maxBodySize > 0 ? _maxBodySize : 0) << " (0=unlimited)"
+              << (_bodyLimit > 0 ? _bodyLimit : 0) << " (0=unlimited)"
               << std::endl;
   }
 #endif
@@ -44,7 +43,11 @@ void HttpParser::parseBodyFixedLength() {
 
   std::size_t toRead = std::min(_buffer.size(), remaining);
   if (toRead > 0) {
-    _request.addBody(_buffer.begin(), _buffer.begin() + toRead);
+    if (!_request.addBody(_buffer.data(), toRead)) {
+      _errorStatusCode = 500;  // no se pudo escribir el fichero temporal
+      _state = ERROR;
+      return;
+    }
     // necesito saber cuantos bytes del body he llevo acumulados para saber si
     // he leido todo el body.
     //  y comparar con el content-length para saber si he leido todo el body.
@@ -58,8 +61,8 @@ void HttpParser::parseBodyFixedLength() {
     }
 #endif
 
-    // elimino los bytes leidos del buffer para no leerlos de nuevo.
-    _buffer.erase(0, toRead);
+    // consumo los bytes leidos del buffer para no leerlos de nuevo.
+    _buffer.consume(toRead);
   }
 
   if (_bytesRead == _contentLength) {
@@ -71,35 +74,44 @@ void HttpParser::parseBodyFixedLength() {
   }
 }
 
+// Valor de un dígito hexadecimal, -1 si no lo es
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
 bool HttpParser::parseChunkSizeLine(std::size_t& size) {
-  std::string line;
-  std::string::size_type semi;
-  char* endPtr = 0;
-  unsigned long value = 0;
+  Slice line;
+  std::size_t value = 0;
+  std::size_t digits = 0;
 
-  if (!extractLine(line)) return false;  // falta data
-  // OJO! Según el protocolo, aquí debe haber un número. Si no hay, es un error.
-  if (line.empty()) {
-    _errorStatusCode = 400;
-    _state = ERROR;
-    return false;
-  }
+  if (!nextLine(line)) return false;  // falta data
+  const char* begin = at(line);
+  std::size_t len = line.len;
 
+  // OJO! Según el protocolo, aquí debe haber un número. Si no hay, es un error.
   // OJO! El estándar HTTP (RFC 9112) dice explícitamente: "Un receptor DEBE
   // ignorar las extensiones de chunk que no comprenda
-  //  Ignorar extensiones (ej: "1a;ext=foo")
-  semi = line.find(';');
-  if (semi != std::string::npos) line = line.substr(0, semi);
-  // strtoul mueve el puntero endPtr hasta donde dejó de leer.
-  // Si endPtr se queda al principio del string (line.c_str()), significa que no
-  // pudo leer ni un solo número válido.
-  value = std::strtoul(line.c_str(), &endPtr, 16);
-  if (endPtr == line.c_str()) {
+  //  Ignorar extensiones (ej: "1a;ext=foo"): leemos dígitos hex hasta el
+  //  primero que no lo sea.
+  for (; digits < len && hexValue(begin[digits]) >= 0; ++digits) {
+    // Un tamaño que no cabe en size_t no es un chunk que podamos aceptar
+    if (value > (static_cast<std::size_t>(-1) >> 4)) {
+      _errorStatusCode = 400;
+      _state = ERROR;
+      return false;
+    }
+    value = (value << 4) | static_cast<std::size_t>(hexValue(begin[digits]));
+  }
+  if (digits == 0) {
     _errorStatusCode = 400;
     _state = ERROR;
     return false;
   }
 
+  consumeLines();
   size = value;
   return true;
 }
@@ -122,28 +134,38 @@ bool HttpParser::handleChunkSizeState() {
 }
 
 // Según el protocolo HTTP, cada fragmento de datos debe terminar con un \r\n
+// Los datos se copian al body a medida que llegan (_chunkSize = lo que falta),
+// no hace falta tener el chunk entero en el buffer.
 bool HttpParser::handleChunkDataState() {
-  // Necesitamos datos + "\r\n"
-  std::size_t needed = _chunkSize + 2;
-  // OJO! Si el buffer no tiene suficientes bytes, faltan datos.
-  if (_buffer.size() < needed) return false;  // falta data
+  std::size_t toRead = std::min(_buffer.size(), _chunkSize);
 
-  if (_buffer[_chunkSize] != '\r' || _buffer[_chunkSize + 1] != '\n') {
-    _errorStatusCode = 400;
+  // Límite de body desde config: un chunked body que supera max_body_size se
+  // rechaza antes de guardar los bytes que sobran
+  if (_bodyLimit > 0 && toRead > _bodyLimit - _request.getBody().size()) {
+    _errorStatusCode = 413;
     _state = ERROR;
     return false;
   }
-  // solo copiamos los datos, no copiamos el \r\n
-  if (_chunkSize > 0)
-    _request.addBody(_buffer.begin(), _buffer.begin() + _chunkSize);
-  _buffer.erase(0, needed);  // datos + CRLF
 
-  // Límite de body desde config: rechazar si chunked body supera max_body_size
-  if (_maxBodySize > 0 && _request.getBody().size() > _maxBodySize) {
-    _errorStatusCode = 413;
+  if (toRead > 0) {
+    if (!_request.addBody(_buffer.data(), toRead)) {
+      _errorStatusCode = 500;  // no se pudo escribir el fichero temporal
+      _state = ERROR;
+      return false;
+    }
+    _buffer.consume(toRead);
+    _chunkSize -= toRead;
+  }
+
+  // Faltan datos del chunk, o su "\r\n"
+  if (_chunkSize > 0 || _buffer.size() < 2) return false;
+
+  if (_buffer[0] != '\r' || _buffer[1] != '\n') {
+    _errorStatusCode = 400;
     _state = ERROR;
     return false;
   }
+  _buffer.consume(2);
 
   _stateChunk = CHUNK_SIZE;
   return true;
@@ -161,10 +183,11 @@ Expires: Wed, 21 Oct 2025 07:28:00 GMT\r\n  <-- ESTO ES UN TRAILER
 */
 bool HttpParser::handleChunkEndState() {
   // Después de "0\r\n" puede venir "\r\n" final o trailers.
-  std::string line;
-  if (!extractLine(line)) return false;  // falta data
+  Slice line;
+  if (!nextLine(line)) return false;  // falta data
+  consumeLines();
 
-  if (line.empty()) {
+  if (line.len == 0) {
     _stateChunk = CHUNK_COMPLETE;
     _state = COMPLETE;
     return false;
@@ -1,43 +1,67 @@
-#include <cstdlib>
 #include <iostream>
 
 #include "HttpHeaderUtils.hpp"
 #include "HttpParser.hpp"
-
-// Helpers moved to HttpHeaderUtils
+#include "HttpScan.hpp"
 
 /**
- * @brief Divide una linea de header en key y value
+ * @brief Divide una linea de header en key y value (trozos del buffer, sin
+ * copiar). La key va tal cual, el value sin espacios/tabs a los lados.
+ * Falla si la key no es un token o el value tiene caracteres de control.
  *
  */
-bool HttpParser::splitHeaderLine(const std::string& line, std::string& key,
-                                 std::string& value) {
-  return http_header_utils::splitHeaderLine(line, key, value);
+bool HttpParser::splitHeaderLine(const Slice& line, HeaderField& field) const {
+  const char* begin = at(line);
+  // El nombre es un token seguido de ':' (sin espacios antes, RFC 9112)
+  std::size_t colon = http_scan::tokenLength(begin, line.len);
+  if (colon == 0 || colon == line.len || begin[colon] != ':') return false;
+
+  std::size_t start = colon + 1;
+  std::size_t end = line.len;
+  while (start < end && (begin[start] == ' ' || begin[start] == '\t')) ++start;
+  while (end > start && (begin[end - 1] == ' ' || begin[end - 1] == '\t'))
+    --end;
+  // Sin caracteres de control en el valor
+  if (http_scan::fieldValueLength(begin + start, end - start) != end - start)
+    return false;
+
+  field.key.offset = line.offset;
+  field.key.len = colon;
+  field.value.offset = line.offset + start;
+  field.value.len = end - start;
+  field.id = HeaderTable::lookup(begin, colon);
+  return true;
+}
+
+// Como strtoul(value, 0, 10): lee dígitos hasta el primero que no lo sea y
+// satura si no cabe (el límite de body lo rechazará con 413)
+static std::size_t parseDecimal(const char* value, std::size_t len) {
+  const std::size_t max = static_cast<std::size_t>(-1);
+  std::size_t result = 0;
+
+  for (std::size_t i = 0; i < len && value[i] >= '0' && value[i] <= '9'; ++i) {
+    std::size_t digit = value[i] - '0';
+    if (result > (max - digit) / 10) return max;
+    result = result * 10 + digit;
+  }
+  return result;
 }
 
 /**
- * se encarga de manejar los headers de la peticion y
- *   añadirlos al mapa de headers del request ademas de
- *   manejar el content-length y el transfer-encoding activando
- *   el la flag de chunk si es necesario
- * @param key: La key del header
- * @param value: El valor del header
+ * se encarga de manejar los headers de la peticion que cambian como se lee
+ *   el body: el content-length y el transfer-encoding activando
+ *   el la flag de chunk si es necesario. El header ya viene identificado
+ *   (HeaderTable::lookup), no se compara el nombre otra vez.
+ * @param field: key y value del header
  */
-void HttpParser::handleHeader(const std::string& key,
-                              const std::string& value) {
-  std::string keyLower;
-  std::string valueLower;
-
-  // Normalizamos una sola vez y usamos la misma clave para:
-  // 1) guardar en el mapa
-  // 2) comparar
-  keyLower = http_header_utils::toLowerCopy(key);
-  _request.addHeaders(keyLower, value);
-  if (keyLower == "content-length") {
+void HttpParser::handleHeader(const HeaderField& field) {
+  const char* value = at(field.value);
+
+  if (field.id == HTTP_HEADER_CONTENT_LENGTH) {
     // convierte el valor a un numero entero
     // cuántos bytes exactos debe esperar antes de marcar la petición como
     // COMPLETE.
-    _contentLength = std::strtoul(value.c_str(), 0, 10);
+    _contentLength = parseDecimal(value, field.value.len);
 #ifdef DEBUG
     std::cerr << "[PARSER HEADER] Content-Length: " << _contentLength
               << " bytes";
@@ -50,11 +74,12 @@ void HttpParser::handleHeader(const std::string& key,
     return;
   }
 
-  if (keyLower == "transfer-encoding") {
+  if (field.id == HTTP_HEADER_TRANSFER_ENCODING) {
     // Esto hará que tu parser ignore el Content-Length y use la lógica
     // de los "vagones" (hexadecimales) que programaste en parseBodyChunked()
-    valueLower = http_header_utils::toLowerCopy(value);
-    if (valueLower.find("chunked") != std::string::npos) _isChunked = true;
+    if (http_header_utils::containsIgnoreCase(value, field.value.len,
+                                              "chunked"))
+      _isChunked = true;
   }
 }
 
@@ -65,7 +90,7 @@ void HttpParser::handleHeader(const std::string& key,
 bool HttpParser::validateHeaders() const {
   // Host es obligatorio en HTTP/1.1
   if (_request.getVersion() == HTTP_VERSION_1_1 &&
-      _request.getHeader("host").empty())
+      _request.getHeader(HTTP_HEADER_HOST).empty())
     return false;
 
   // Si llegan ambos headers (Transfer-Encoding y Content-Length),
@@ -77,32 +102,53 @@ bool HttpParser::validateHeaders() const {
   return true;
 }
 
-bool HttpParser::processHeaderLine(const std::string& line) {
-  std::string key;
-  std::string value;
+bool HttpParser::processHeaderLine(const Slice& line) {
+  HeaderField field;
 
-  if (!splitHeaderLine(line, key, value)) return false;
+  if (!splitHeaderLine(line, field)) return false;
 
-  handleHeader(key, value);
+  handleHeader(field);
+  _fields.push_back(field);
   return true;
 }
 
+/**
+ * @brief Fin de la cabecera: pasa los headers al request y consume del
+ * buffer toda la cabecera de una vez (start line incluida).
+ */
+void HttpParser::commitHead() {
+  for (std::size_t i = 0; i < _fields.size(); ++i) {
+    const HeaderField& field = _fields[i];
+    if (field.id != HTTP_HEADER_OTHER)
+      _request.addHeaders(field.id, at(field.value), field.value.len);
+    else
+      _request.addHeaders(at(field.key), field.key.len, at(field.value),
+                          field.value.len);
+  }
+  consumeLines();
+}
+
 // PARSE HEADERS -------------------------------------------------------------
 void HttpParser::parseHeaders() {
   while (true) {
-    std::string line;
-    if (!extractLine(line))
-      return;  // No hay línea completa, esperamos al siguiente epoll()
-    // Caso 1: Línea vacía -> Fin de headers
-    if (line.empty() && !validateHeaders()) {
-      _errorStatusCode =
-          (_maxBodySize > 0 && _contentLength > _maxBodySize) ? 413 : 400;
-      _state = ERROR;
+    Slice line;
+    if (!nextLine(line)) {
+      // No hay línea completa, esperamos al siguiente epoll() (salvo que lo
+      // recibido ya supere los límites)
+      checkHeadLimits(_buffer.size() - _cursor, _buffer.size());
       return;
     }
-
-    if (line.empty())  // fin de headers \r\n\r\n
-    {
+    if (!checkHeadLimits(line.len, _cursor)) return;
+    // Caso 1: Línea vacía -> Fin de headers
+    if (line.len == 0) {
+      commitHead();
+      if (!validateHeaders()) {
+        _errorStatusCode =
+            (_maxBodySize > 0 && _contentLength > _maxBodySize) ? 413 : 400;
+        _state = ERROR;
+        return;
+      }
+      // fin de headers \r\n\r\n
       if (_isChunked == true || _contentLength > 0)
         _state = PARSING_BODY;
       else
@@ -111,6 +157,11 @@ void HttpParser::parseHeaders() {
     }
 
     // Caso 2: Línea con datos -> Procesar
+    if (_maxHeaderCount > 0 && _fields.size() >= _maxHeaderCount) {
+      _errorStatusCode = 431;
+      _state = ERROR;
+      return;
+    }
     if (!processHeaderLine(line)) {
       _errorStatusCode = 400;
       _state = ERROR;
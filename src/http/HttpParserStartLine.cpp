@@ -1,28 +1,66 @@
+#include <cstring>
+
 #include "HttpParser.hpp"
+#include "HttpScan.hpp"
+
+const char* HttpParser::at(const Slice& slice) const {
+  return _buffer.data() + slice.offset;
+}
+
 /**
- * Extrae una línea completa del buffer interno (_buffer) y la guarda en la
- * variable line.
- * @param line: La línea extraída del buffer.
- * @return: true si se extrajo la línea, false si no.
+ * Busca la siguiente línea completa a partir del cursor, sin copiarla ni
+ * borrarla del buffer: line apunta a ella y el cursor pasa a la siguiente.
+ * @param line: La línea encontrada (sin el \r\n).
+ * @return: true si hay una línea completa, false si falta data.
  * ejemplo de buffer: GET /index.html HTTP/1.1\r\nHost: www.example.com\r\n\r\n
- * extractLine devuelve GET /index.html HTTP/1.1
- * borra el buffer "GET /index.html HTTP/1.1\r\n"
- * buffer queda "Host: www.example.com\r\n\r\n"
- * y line queda "GET /index.html HTTP/1.1"
- * y el estado del parser es PARSING_HEADERS ???
+ * line queda {0, 24} -> "GET /index.html HTTP/1.1"
+ * y el cursor queda en "Host: www.example.com\r\n\r\n"
+ * Si falta data, lo ya escaneado no se vuelve a mirar en la siguiente
+ * llamada (_scanPos), una línea que llega en muchos recv() no es cuadrática.
  */
-bool HttpParser::extractLine(std::string& line) {
-  std::string::size_type pos;
-
-  pos = _buffer.find("\r\n");
-  if (pos == std::string::npos) return false;
-  // si no la borras, la procesarías otra vez en la siguiente llamada.
-  // Borrarla significa: “ya está consumida”,
-  line = _buffer.substr(0, pos);
-  _buffer.erase(0, pos + 2);
+bool HttpParser::nextLine(Slice& line) {
+  std::size_t from = (_scanPos > _cursor) ? _scanPos : _cursor;
+  std::size_t pos = http_scan::npos;
+
+  if (from < _buffer.size()) {
+    pos = http_scan::findCrlf(_buffer.data() + from, _buffer.size() - from);
+    if (pos != http_scan::npos) pos += from;
+  }
+  if (pos == http_scan::npos) {
+    // el último byte puede ser el '\r' de un "\r\n" partido
+    if (_buffer.size() > 0) _scanPos = _buffer.size() - 1;
+    return false;
+  }
+  line.offset = _cursor;
+  line.len = pos - _cursor;
+  _cursor = pos + 2;
+  _scanPos = _cursor;
   return true;
 }
 
+/**
+ * Límites de cabecera (setHeaderLimits) para la línea en curso: lineLen es
+ * su longitud (o lo recibido de ella si aún no llegó el "\r\n") y headBytes
+ * todo lo leído de la cabecera hasta ahora. Si no caben pasa a ERROR: 414 en
+ * la start line, 431 en los headers.
+ */
+bool HttpParser::checkHeadLimits(std::size_t lineLen, std::size_t headBytes) {
+  if ((_maxLineSize == 0 || lineLen <= _maxLineSize) &&
+      (_maxHeadSize == 0 || headBytes <= _maxHeadSize))
+    return true;
+  _errorStatusCode = (_state == PARSING_START_LINE) ? 414 : 431;
+  _state = ERROR;
+  return false;
+}
+
+// Consume del buffer todo lo recorrido por el cursor (cabecera completa o
+// líneas del body chunked) y vuelve a empezar desde data().
+void HttpParser::consumeLines() {
+  _buffer.consume(_cursor);
+  _cursor = 0;
+  _scanPos = 0;
+}
+
 /**
  * Divide la línea de inicio de la petición HTTP en method, uri y version.
  * @param line: La línea de inicio de la petición HTTP.
@@ -35,22 +73,29 @@ bool HttpParser::extractLine(std::string& line) {
  * uri: "/index.html" secondSpace: 27
  * version: "HTTP/1.1"
  */
-bool HttpParser::splitStartLine(const std::string& line, std::string& method,
-                                std::string& uri, std::string& version) {
+bool HttpParser::splitStartLine(const Slice& line, Slice& method, Slice& uri,
+                                Slice& version) const {
   // METHOD SP URI SP VERSION -> 3 partes
-  std::string::size_type firstSpace;
-  std::string::size_type secondSpace;
-
-  firstSpace = line.find(' ');
-  if (firstSpace == std::string::npos) return false;
-
-  secondSpace = line.find(' ', firstSpace + 1);
-  if (secondSpace == std::string::npos) return false;
-
-  method = line.substr(0, firstSpace);
-  uri = line.substr(firstSpace + 1,
-                    secondSpace - firstSpace - 1);  // size de la uri
-  version = line.substr(secondSpace + 1);
+  const char* begin = at(line);
+  const char* end = begin + line.len;
+  const char* firstSpace;
+  const char* secondSpace;
+
+  // El método es un token: tiene que terminar justo en el primer espacio
+  firstSpace = begin + http_scan::tokenLength(begin, line.len);
+  if (firstSpace == begin || firstSpace == end || *firstSpace != ' ')
+    return false;
+
+  secondSpace = static_cast<const char*>(
+      std::memchr(firstSpace + 1, ' ', end - firstSpace - 1));
+  if (secondSpace == NULL) return false;
+
+  method.offset = line.offset;
+  method.len = firstSpace - begin;
+  uri.offset = line.offset + (firstSpace + 1 - begin);
+  uri.len = secondSpace - firstSpace - 1;  // size de la uri
+  version.offset = line.offset + (secondSpace + 1 - begin);
+  version.len = end - secondSpace - 1;
 
   return true;
 }
@@ -65,24 +110,29 @@ bool HttpParser::splitStartLine(const std::string& line, std::string& method,
  * Ejemplos que NO rechazamos: file..txt, /foto..jpg (son nombres de archivo
  * normales)
  */
-static bool containsParentPathSegment(const std::string& path) {
-  std::string::size_type search_pos = 0;
+static bool containsParentPathSegment(const char* path, std::size_t len) {
+  std::size_t search_pos = 0;
 
-  while (search_pos < path.length()) {
+  while (search_pos + 1 < len) {
     // Buscar la siguiente aparición de ".."
-    std::string::size_type found_at = path.find("..", search_pos);
+    const char* dot = static_cast<const char*>(
+        std::memchr(path + search_pos, '.', len - search_pos - 1));
 
-    if (found_at == std::string::npos) {
+    if (dot == NULL) {
       // No hay más "..", el path está bien
       return false;
     }
+    std::size_t found_at = dot - path;
+    if (path[found_at + 1] != '.') {
+      search_pos = found_at + 1;
+      continue;
+    }
 
     // ¿Está el ".." justo al inicio del path o después de una barra?
     bool is_valid_start = (found_at == 0) || (path[found_at - 1] == '/');
 
     // ¿Termina el ".." al final del path o va seguido de una barra?
-    bool is_valid_end =
-        (found_at + 2 >= path.length()) || (path[found_at + 2] == '/');
+    bool is_valid_end = (found_at + 2 >= len) || (path[found_at + 2] == '/');
 
     if (is_valid_start && is_valid_end) {
       // Encontramos ".." como segmento de path -> intento de directory
@@ -101,31 +151,25 @@ static bool containsParentPathSegment(const std::string& path) {
  * Extrae el path y el query string de la URI.
  * Ejemplo: "/index.html?nombre=ana" -> path="/index.html", query="nombre=ana"
  */
-void HttpParser::parseUri(const std::string& uri) {
-  std::string path;
-  std::string query;
-
+void HttpParser::parseUri(const char* uri, std::size_t len) {
   // Separar path y query por el ?
   // Ejemplo: /index.html?nombre=ana -> path="/index.html", query="nombre=ana"
-  std::string::size_type question_mark_pos = uri.find('?');
-
-  if (question_mark_pos != std::string::npos) {
-    path = uri.substr(0, question_mark_pos);
-    query = uri.substr(question_mark_pos + 1);
-  } else {
-    path = uri;
-    query = "";
-  }
+  const char* question_mark =
+      static_cast<const char*>(std::memchr(uri, '?', len));
+  std::size_t path_len = question_mark ? question_mark - uri : len;
 
   // Seguridad: bloquear intentos de salir del directorio (directory traversal)
-  if (containsParentPathSegment(path)) {
+  if (containsParentPathSegment(uri, path_len)) {
     _errorStatusCode = 403;
     _state = ERROR;
     return;
   }
 
-  _request.setPath(path);
-  _request.setQuery(query);
+  _request.setPath(std::string(uri, path_len));
+  if (question_mark)
+    _request.setQuery(std::string(question_mark + 1, len - path_len - 1));
+  else
+    _request.setQuery("");
 }
 
 // PARSE START LINE ----------------------------------------------------------
@@ -135,17 +179,25 @@ void HttpParser::parseUri(const std::string& uri) {
  * version.
  */
 void HttpParser::parseStartLine() {
-  std::string line;
-  std::string method;
-  std::string uri;
-  std::string version;
-
-  if (!extractLine(line)) return;
+  Slice line;
+  Slice method;
+  Slice uri;
+  Slice version;
+
+  // Sin "\r\n" todavía: lo recibido ya cuenta para los límites
+  if (!nextLine(line)) {
+    checkHeadLimits(_buffer.size() - _cursor, _buffer.size());
+    return;
+  }
 
   // Ignorar líneas vacías (ej: \r\n al inicio) y esperar la start line real
-  while (line.empty()) {
-    if (!extractLine(line)) return;
+  while (line.len == 0) {
+    if (!nextLine(line)) {
+      checkHeadLimits(_buffer.size() - _cursor, _buffer.size());
+      return;
+    }
   }
+  if (!checkHeadLimits(line.len, _cursor)) return;
 
   if (!splitStartLine(line, method, uri, version)) {
     _errorStatusCode = 400;
@@ -154,9 +206,9 @@ void HttpParser::parseStartLine() {
   }
 
   // Porque HttpRequest es la estructura que guarda la petición ya parseada.
-  _request.setMethod(method);
-  _request.setVersion(version);
-  parseUri(uri);
+  _request.setMethod(at(method), method.len);
+  _request.setVersion(at(version), version.len);
+  parseUri(at(uri), uri.len);
 
   // actualizo el estado
   //  DEBUG:
@@ -1,7 +1,10 @@
 #include "HttpRequest.hpp"
 
-#include <algorithm>  //para convertir a mayúsculas transform
-#include <cctype>     //para convertir a minúsculas
+#include <cctype>  //para convertir a mayúsculas
+#include <cstring>
+
+#include "HttpHeaderUtils.hpp"
+#include "MultipartParser.hpp"
 
 // ============================================================================
 // CONSTRUCTOR Y DESTRUCTOR
@@ -17,7 +20,7 @@ HttpRequest::HttpRequest()
       _query() {}
 // constructor de inicialización
 HttpRequest::HttpRequest(const std::string& method, const std::string& version,
-                         const HeaderMap& headers, const std::string& path,
+                         const HeaderTable& headers, const std::string& path,
                          const std::string& query,
                          const std::vector<char>& body)
     : _method(HTTP_METHOD_UNKNOWN),
@@ -26,7 +29,8 @@ HttpRequest::HttpRequest(const std::string& method, const std::string& version,
       _status(HTTP_STATUS_PENDING),
       _path(path),
       _query(query),
-      _body(body) {
+      _body() {
+  if (!body.empty()) _body.append(&body[0], body.size());
   setMethod(method);    // ← Convierte "GET" → HTTP_METHOD_GET
   setVersion(version);  // ← Convierte "HTTP/1.1" → HTTP_VERSION_1_1
 }
@@ -65,46 +69,66 @@ HttpRequest::~HttpRequest() {}
  * @param method
  */
 void HttpRequest::setMethod(const std::string& method) {
-  std::string upperMethod = method;
-  // transform recibe 3 argumentos:
-  // 1. El inicio del rango de caracteres a transformar
-  // 2. El final del rango de caracteres a transformar
-  // 3. El resultado de la transformación
+  setMethod(method.data(), method.size());
+}
 
-  std::transform(upperMethod.begin(), upperMethod.end(), upperMethod.begin(),
-                 ::toupper);
+// Compara sin distinguir mayúsculas contra un literal en mayúsculas, sin
+// copiar el método a un string temporal
+static bool equalsUpper(const char* s, std::size_t len, const char* upper) {
+  std::size_t i = 0;
+  for (; i < len && upper[i]; ++i) {
+    if (std::toupper(static_cast<unsigned char>(s[i])) != upper[i])
+      return false;
+  }
+  return i == len && upper[i] == '\0';
+}
 
-  if (upperMethod == "GET")
+void HttpRequest::setMethod(const char* method, std::size_t len) {
+  if (equalsUpper(method, len, "GET"))
     _method = HTTP_METHOD_GET;
-  else if (upperMethod == "POST")
+  else if (equalsUpper(method, len, "POST"))
     _method = HTTP_METHOD_POST;
-  else if (upperMethod == "DELETE")
+  else if (equalsUpper(method, len, "DELETE"))
     _method = HTTP_METHOD_DELETE;
-  else if (upperMethod == "HEAD")
+  else if (equalsUpper(method, len, "HEAD"))
     _method = HTTP_METHOD_HEAD;
   else
     _method = HTTP_METHOD_UNKNOWN;
 }
 
 void HttpRequest::setVersion(const std::string& version) {
-  if (version == "HTTP/1.0")
+  setVersion(version.data(), version.size());
+}
+
+void HttpRequest::setVersion(const char* version, std::size_t len) {
+  if (len == 8 && std::memcmp(version, "HTTP/1.0", 8) == 0)
     _version = HTTP_VERSION_1_0;
-  else if (version == "HTTP/1.1")
+  else if (len == 8 && std::memcmp(version, "HTTP/1.1", 8) == 0)
     _version = HTTP_VERSION_1_1;
   else
     _version = HTTP_VERSION_UNKNOWN;
 }
 
 /**
- * @brief Agrega un header al mapa. La clave debe venir ya normalizada en
- * minúsculas.
+ * @brief Agrega un header a la tabla. Da igual mayúsculas o minúsculas: la
+ * tabla guarda el nombre en minúsculas.
  *
- * @param key : nombre del header (ya en minúsculas)
+ * @param key : nombre del header
  * @param value : contenido del header ej: "localhost:8080"
- * @note HTTP es case-insensitive, por eso el parser normaliza antes.
+ * @note HTTP es case-insensitive, por eso la tabla normaliza.
  */
 void HttpRequest::addHeaders(const std::string& key, const std::string& value) {
-  _headers[key] = value;
+  _headers.set(key, value);
+}
+
+void HttpRequest::addHeaders(const char* key, std::size_t keyLen,
+                             const char* value, std::size_t valueLen) {
+  _headers.set(key, keyLen, value, valueLen);
+}
+
+void HttpRequest::addHeaders(HttpHeaderId id, const char* value,
+                             std::size_t valueLen) {
+  _headers.set(id, value, valueLen);
 }
 
 void HttpRequest::setPath(const std::string& path) { _path = path; }
@@ -116,11 +140,27 @@ void HttpRequest::setQuery(const std::string& query) { _query = query; }
 //     _body.insert(_body.end(), chunk.begin(), chunk.end());
 // }
 
-void HttpRequest::addBody(std::string::const_iterator begin,
+bool HttpRequest::addBody(std::string::const_iterator begin,
                           std::string::const_iterator end) {
-  if (begin == end) return;
-  // vector.insert(donde_pegar, inicio_del_rango, fin_del_rango);
-  _body.insert(_body.end(), begin, end);
+  if (begin == end) return true;
+  return _body.append(&*begin, static_cast<std::size_t>(end - begin));
+}
+
+bool HttpRequest::addBody(const char* data, std::size_t len) {
+  return _body.append(data, len);
+}
+
+void HttpRequest::setBodyBufferSize(std::size_t bytes) {
+  _body.setMemoryLimit(bytes);
+}
+
+bool HttpRequest::storeBodyIn(const std::string& dir, std::size_t expected) {
+  // Un formulario se guarda ya separado en sus ficheros
+  std::string boundary;
+  if (MultipartParser::boundaryFrom(getHeader(HTTP_HEADER_CONTENT_TYPE),
+                                    boundary))
+    return _body.storeFormIn(dir, boundary);
+  return _body.storeIn(dir, expected);
 }
 
 // ============================================================================
@@ -142,37 +182,37 @@ HttpVersion HttpRequest::getVersion() const { return _version; }
  */
 
 const std::string& HttpRequest::getHeader(const std::string& key) const {
-  // TODO: Optimización futura (cachear los resultados)
-
-  std::string lowerKey;
   // static porque se crea una sola vez y se reutiliza en todas las llamadas a
   // la función
   static const std::string empty = "";
 
-  lowerKey = key;
-  std::transform(lowerKey.begin(), lowerKey.end(), lowerKey.begin(), ::tolower);
-  HeaderMap::const_iterator it = _headers.find(lowerKey);
-  if (it != _headers.end()) return it->second;  // value lo que nos interesa
+  const std::string* value = _headers.find(key);
+  return value ? *value : empty;
+}
 
-  return empty;
+const std::string& HttpRequest::getHeader(HttpHeaderId id) const {
+  static const std::string empty = "";
+
+  const std::string* value = _headers.find(id);
+  return value ? *value : empty;
 }
 
 /**
  * @brief Obtiene todos los headers de la petición
  *
- * @return const HttpRequest::HeaderMap& : es un mapa con todos los headers
+ * @return const HeaderTable& : todos los headers, en orden de llegada
  * y util para CGI que necesita iterar sobre todos los headers para variables de
  * entorno.  Carles
  */
-const HttpRequest::HeaderMap& HttpRequest::getHeaders() const {
-  return _headers;  // Devolver referencia constante al mapa completo
+const HeaderTable& HttpRequest::getHeaders() const {
+  return _headers;  // Devolver referencia constante a la tabla completa
 }
 
 std::string HttpRequest::getPath() const { return _path; }
 
 std::string HttpRequest::getQuery() const { return _query; }
 
-const std::vector<char>& HttpRequest::getBody() const { return _body; }
+const RequestBody& HttpRequest::getBody() const { return _body; }
 
 HttpStatus HttpRequest::getStatus() const { return _status; }
 
@@ -212,16 +252,14 @@ void HttpRequest::clear() {
  * HTTP_VERSION_UNKNOWN o versión no soportada: cerrar por seguridad
  */
 bool HttpRequest::shouldCloseConnection() const {
-  std::string connectionHeader;
-
-  connectionHeader = getHeader("Connection");
-  std::transform(connectionHeader.begin(), connectionHeader.end(),
-                 connectionHeader.begin(), ::tolower);
+  const std::string& connection = getHeader(HTTP_HEADER_CONNECTION);
 
   if (_version == HTTP_VERSION_1_1) {
-    return (connectionHeader == "close");
+    return http_header_utils::equalsIgnoreCase(connection.data(),
+                                               connection.size(), "close");
   } else if (_version == HTTP_VERSION_1_0) {
-    return (connectionHeader != "keep-alive");
+    return !http_header_utils::equalsIgnoreCase(
+        connection.data(), connection.size(), "keep-alive");
   } else {
     // HTTP_VERSION_UNKNOWN o versión no soportada: cerrar por seguridad
     return true;
@@ -231,7 +269,7 @@ bool HttpRequest::shouldCloseConnection() const {
 // Comprueba si el cliente envió Expect: 100-continue (espera confirmación
 // antes de mandar un body grande)
 bool HttpRequest::hasExpect100Continue() const {
-  std::string expect = getHeader("expect");
-  std::transform(expect.begin(), expect.end(), expect.begin(), ::tolower);
-  return expect.find("100-continue") != std::string::npos;
+  const std::string& expect = getHeader(HTTP_HEADER_EXPECT);
+  return http_header_utils::containsIgnoreCase(expect.data(), expect.size(),
+                                               "100-continue");
 }
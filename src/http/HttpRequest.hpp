@@ -2,10 +2,12 @@
 #define HTTP_REQUEST_HPP
 
 #include <iostream>
-#include <map>
 #include <string>
 #include <vector>
 
+#include "HeaderTable.hpp"
+#include "RequestBody.hpp"
+
 enum HttpMethod {
   HTTP_METHOD_GET,
   HTTP_METHOD_POST,
@@ -27,22 +29,20 @@ enum HttpVersion { HTTP_VERSION_1_0, HTTP_VERSION_1_1, HTTP_VERSION_UNKNOWN };
 
 class HttpRequest {
  private:
-  typedef std::map<std::string, std::string> HeaderMap;
-
   HttpMethod _method;
   HttpVersion _version;
-  HeaderMap _headers;
+  HeaderTable _headers;
   HttpStatus _status;
   std::string _path;   // URL de la petición ej: "/images/logo.png"
   std::string _query;  // Query string de la petición ej: "?name=John&age=30"
-  std::vector<char> _body;  // vector para soportar binarios y texto grande (ej:
-                            // videos, imagenes, etc.)
+  RequestBody _body;   // binario; pasa a fichero temporal si es grande (ej:
+                       // videos, imagenes, etc.)
  public:
   // constructors
   HttpRequest();
   HttpRequest(const HttpRequest& other);
   HttpRequest(const std::string& method, const std::string& version,
-              const HeaderMap& headers, const std::string& path,
+              const HeaderTable& headers, const std::string& path,
               const std::string& query, const std::vector<char>& body);
   ~HttpRequest();
   HttpRequest& operator=(const HttpRequest& other);
@@ -51,11 +51,25 @@ class HttpRequest {
   void setMethod(const std::string& method);
   void setVersion(const std::string& version);
   void addHeaders(const std::string& key, const std::string& value);
+  // Variantes sobre un trozo del buffer de recepción (el parser no crea
+  // strings intermedios). La key se normaliza a minúsculas aquí.
+  void setMethod(const char* method, std::size_t len);
+  void setVersion(const char* version, std::size_t len);
+  void addHeaders(const char* key, std::size_t keyLen, const char* value,
+                  std::size_t valueLen);
+  void addHeaders(HttpHeaderId id, const char* value, std::size_t valueLen);
   void setPath(const std::string& path);
   void setQuery(const std::string& query);
   // void addBody(const std::vector<char>& chunk);
-  void addBody(std::string::const_iterator begin,
+  // false si el body no se pudo guardar (fichero temporal)
+  bool addBody(std::string::const_iterator begin,
                std::string::const_iterator end);
+  bool addBody(const char* data, std::size_t len);
+  // client_body_buffer_size: a partir de aquí el body va a fichero
+  void setBodyBufferSize(std::size_t bytes);
+  // Upload: el body se escribe directamente en un temporal de dir (o, si es
+  // multipart/form-data, cada fichero del formulario en el suyo)
+  bool storeBodyIn(const std::string& dir, std::size_t expected);
   void setStatus(HttpStatus status);
 
   // getters
@@ -64,11 +78,12 @@ class HttpRequest {
   HttpStatus getStatus() const;
   // getters para headers
   const std::string& getHeader(const std::string& key) const;
-  const HeaderMap& getHeaders() const;
+  const std::string& getHeader(HttpHeaderId id) const;  // O(1)
+  const HeaderTable& getHeaders() const;
   // getters para path y query
   std::string getPath() const;
   std::string getQuery() const;
-  const std::vector<char>& getBody() const;
+  const RequestBody& getBody() const;
 
   // clear
   void clear();
@@ -18,6 +18,10 @@ static std::string reasonPhraseForStatus(int code) {
       return "Method Not Allowed";
     case HTTP_STATUS_REQUEST_ENTITY_TOO_LARGE:
       return "Request Entity Too Large";
+    case HTTP_STATUS_URI_TOO_LONG:
+      return "URI Too Long";
+    case HTTP_STATUS_HEADER_FIELDS_TOO_LARGE:
+      return "Request Header Fields Too Large";
     case HTTP_STATUS_INTERNAL_SERVER_ERROR:
       return "Internal Server Error";
     default:
@@ -67,7 +71,11 @@ void HttpResponse::setStatusCode(int code) {
 }
 
 void HttpResponse::setHeader(const std::string& key, const std::string& value) {
-  _headers[http_header_utils::toLowerCopy(key)] = value;
+  _headers.set(key, value);
+}
+
+void HttpResponse::setHeader(HttpHeaderId id, const std::string& value) {
+  _headers.set(id, value.data(), value.size());
 }
 
 void HttpResponse::setVersion(const std::string& version) {
@@ -86,46 +94,57 @@ void HttpResponse::setReasonPhrase(const std::string& reason) {
 void HttpResponse::setHeadOnly(bool value) { _headOnly = value; }
 // el reto es pegar la cabecera
 // setters para binarios (imagenes)
-void HttpResponse::setBody(const std::vector<char>& body) { _body = body; }
+void HttpResponse::setBody(const std::vector<char>& body) {
+  _body.assign(body.empty() ? NULL : &body[0], body.size());
+}
+
+void HttpResponse::takeBody(std::vector<char>& body) { _body.adopt(body); }
 
 void HttpResponse::setBody(const std::string& body) {
-  _body.assign(body.begin(), body.end());
+  _body.assign(body.data(), body.size());
 }
 
 bool HttpResponse::hasHeader(const std::string& key) const {
-  HeaderMap::const_iterator it =
-      _headers.find(http_header_utils::toLowerCopy(key));
-  return it != _headers.end();
+  return _headers.find(key) != NULL;
+}
+
+bool HttpResponse::hasHeader(HttpHeaderId id) const {
+  return _headers.find(id) != NULL;
 }
 
 // SERIALIZE
-std::vector<char> HttpResponse::serialize() const {
+std::string HttpResponse::serializeHead() const {
   std::stringstream buffer;
 
   buffer << versionToString(_version) << " " << _status << " " << _reasonPhrase
          << "\r\n";
 
-  for (HeaderMap::const_iterator it = _headers.begin(); it != _headers.end();
-       ++it) {
-    if (http_header_utils::toLowerCopy(it->first) == "content-length") continue;
-    buffer << it->first << ": " << it->second << "\r\n";
+  for (std::size_t i = 0; i < _headers.size(); ++i) {
+    if (_headers.idAt(i) == HTTP_HEADER_CONTENT_LENGTH) continue;
+    buffer << _headers.nameAt(i) << ": " << _headers.valueAt(i) << "\r\n";
   }
 
   buffer << "Content-Length: " << _body.size() << "\r\n";
   buffer << "\r\n";
+  return buffer.str();
+}
 
-  // convertir la parte de texto a vector
-  std::string headStr = buffer.str();
+std::vector<char> HttpResponse::serialize() const {
+  std::string headStr = serializeHead();
   std::vector<char> response(headStr.begin(), headStr.end());
 
   // insertar el cuerpo binario al final
-  if (!_headOnly) {
-    response.insert(response.end(), _body.begin(), _body.end());
+  if (!_headOnly && !_body.empty()) {
+    response.insert(response.end(), _body.data(), _body.data() + _body.size());
   }
 
   return (response);
 }
 
+const SharedBuffer& HttpResponse::getBody() const { return _body; }
+
+bool HttpResponse::isHeadOnly() const { return _headOnly; }
+
 void HttpResponse::setContentType(const std::string& filename) {
   std::string::size_type dotPos = filename.find_last_of('.');
   std::string ext;
@@ -159,7 +178,7 @@ void HttpResponse::setContentType(const std::string& filename) {
   else if (ext == "pdf")
     contentType = "application/pdf";
 
-  setHeader("Content-Type", contentType);
+  setHeader(HTTP_HEADER_CONTENT_TYPE, contentType);
 }
 
 void HttpResponse::clear() {
@@ -1,11 +1,12 @@
 #ifndef HTTP_RESPONSE_HPP
 #define HTTP_RESPONSE_HPP
 
-#include <map>
 #include <string>
 #include <vector>
 
+#include "HeaderTable.hpp"
 #include "HttpRequest.hpp"  // para reutilizar HttpVersion
+#include "common/SharedBuffer.hpp"
 
 // Códigos de estado mínimos para empezar.
 enum HttpStatusCode {
@@ -16,18 +17,21 @@ enum HttpStatusCode {
   HTTP_STATUS_NOT_FOUND = 404,
   HTTP_STATUS_METHOD_NOT_ALLOWED = 405,
   HTTP_STATUS_REQUEST_ENTITY_TOO_LARGE = 413,
+  HTTP_STATUS_URI_TOO_LONG = 414,
+  HTTP_STATUS_HEADER_FIELDS_TOO_LARGE = 431,
   HTTP_STATUS_INTERNAL_SERVER_ERROR = 500
 };
 
 // Representa una respuesta HTTP que se enviará al cliente.
+// El body es un SharedBuffer: copiar la respuesta (o encolarla para enviar)
+// comparte los bytes en lugar de duplicarlos.
 class HttpResponse {
  private:
-  typedef std::map<std::string, std::string> HeaderMap;
   HttpStatusCode _status;
   HttpVersion _version;
-  HeaderMap _headers;
+  HeaderTable _headers;
   std::string _reasonPhrase;
-  std::vector<char> _body;
+  SharedBuffer _body;
   bool _headOnly;
 
  public:
@@ -40,7 +44,10 @@ class HttpResponse {
 
   void setStatusCode(int code);
   void setBody(const std::vector<char>& body);
+  // Sin copia: se queda con los bytes de `body` (que queda vacio)
+  void takeBody(std::vector<char>& body);
   void setHeader(const std::string& key, const std::string& value);
+  void setHeader(HttpHeaderId id, const std::string& value);
   void setVersion(const std::string& version);
   void setHeadOnly(bool value);
   // La «razón» (reason phrase) en las respuestas HTTP es un texto breve y
@@ -54,6 +61,11 @@ class HttpResponse {
   // lo hago vector para que poder enviarlo bien a send() sin que corte si
   // hay un byte nulo en medio de una imagen.
   std::vector<char> serialize() const;
+  // Status line + headers + CRLF. El body va aparte (getBody), sin copiarlo
+  // detras de la cabecera.
+  std::string serializeHead() const;
+  const SharedBuffer& getBody() const;
+  bool isHeadOnly() const;
 
   // HELPERS
   // segun la extension del archivo
@@ -61,6 +73,7 @@ class HttpResponse {
   // comprobar si ya existe un header (se usa para no sobreescribir
   // Content-Type)
   bool hasHeader(const std::string& key) const;
+  bool hasHeader(HttpHeaderId id) const;
 
   void clear();
 };
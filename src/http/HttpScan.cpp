@@ -0,0 +1,317 @@
+#include "HttpScan.hpp"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HTTP_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace http_scan {
+
+// ============================================================================
+// TABLAS
+// ============================================================================
+
+namespace {
+
+// Clasificación de cada byte: escalar directo, y para SIMD la misma tabla
+// partida por nibbles (pshufb): el byte b es válido si
+// lo[b & 0xf] tiene el bit (b >> 4) a 1 (solo hay bits para b < 0x80).
+struct Tables {
+  bool token[256];
+  bool fieldValue[256];
+  unsigned char tokenLo[32];  // 16 bytes repetidos (los dos carriles AVX2)
+  unsigned char hiBit[32];    // 1 << hi para hi < 8, 0 para hi >= 8
+
+  Tables() {
+    const char* tcharSymbols = "!#$%&'*+-.^_`|~";
+    std::memset(tokenLo, 0, sizeof(tokenLo));
+    for (int c = 0; c < 256; ++c) {
+      token[c] = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+                 (c >= 'A' && c <= 'Z') ||
+                 (c != 0 && std::strchr(tcharSymbols, c) != NULL);
+      fieldValue[c] = c == '\t' || (c >= 0x20 && c != 0x7f);
+      if (token[c]) {
+        tokenLo[c & 0xf] |= static_cast<unsigned char>(1 << (c >> 4));
+        tokenLo[16 + (c & 0xf)] = tokenLo[c & 0xf];
+      }
+    }
+    for (int i = 0; i < 16; ++i) {
+      hiBit[i] = hiBit[16 + i] =
+          static_cast<unsigned char>(i < 8 ? 1 << i : 0);
+    }
+  }
+};
+
+const Tables tables;
+
+// ============================================================================
+// ESCALAR
+// ============================================================================
+
+std::size_t findCrlfScalar(const char* data, std::size_t len) {
+  const char* end = data + len;
+  const char* p = data;
+
+  while (p + 1 < end) {
+    p = static_cast<const char*>(std::memchr(p, '\r', end - p - 1));
+    if (p == NULL) return npos;
+    if (p[1] == '\n') return p - data;
+    ++p;
+  }
+  return npos;
+}
+
+std::size_t tokenLengthScalar(const char* data, std::size_t len) {
+  std::size_t i = 0;
+  while (i < len && tables.token[static_cast<unsigned char>(data[i])]) ++i;
+  return i;
+}
+
+std::size_t fieldValueLengthScalar(const char* data, std::size_t len) {
+  std::size_t i = 0;
+  while (i < len && tables.fieldValue[static_cast<unsigned char>(data[i])]) ++i;
+  return i;
+}
+
+#ifdef HTTP_SCAN_X86
+
+// ============================================================================
+// SSE4.2
+// ============================================================================
+
+// Un bloque de 16 bytes. Se inlinean también en las versiones AVX2 (allí se
+// codifican como VEX): llamar a código SSE no-VEX con la mitad alta de los
+// registros ymm sucia penaliza todo el SSE que venga después.
+#define HTTP_SCAN_SSE42 __attribute__((target("sse4.2"), always_inline))
+
+// Bits a 1 = "\r" en p[k] seguido de "\n" (lee p[0..16])
+static inline HTTP_SCAN_SSE42 int crlfMask16(const char* p) {
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+  return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, _mm_set1_epi8('\r')),
+                                         _mm_cmpeq_epi8(b, _mm_set1_epi8('\n'))));
+}
+
+// Bits a 1 = bytes que no son tchar (lookup por nibbles, ver Tables)
+static inline HTTP_SCAN_SSE42 int invalidTokenMask16(const char* p) {
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i lo =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.tokenLo));
+  __m128i hiBit =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.hiBit));
+  __m128i loBits = _mm_shuffle_epi8(lo, _mm_and_si128(v, nibble));
+  __m128i hiBits =
+      _mm_shuffle_epi8(hiBit, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+  __m128i valid = _mm_and_si128(loBits, hiBits);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128()));
+}
+
+// PCMPESTRI con rangos: índice del primer byte en 0x00-0x08, 0x0a-0x1f o
+// 0x7f, 16 si no hay ninguno
+static inline HTTP_SCAN_SSE42 int invalidValueIndex16(const char* p) {
+  const __m128i ranges = _mm_setr_epi8(0x00, 0x08, 0x0a, 0x1f, 0x7f, 0x7f, 0,
+                                       0, 0, 0, 0, 0, 0, 0, 0, 0);
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  return _mm_cmpestri(ranges, 6, v, 16,
+                      _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                          _SIDD_LEAST_SIGNIFICANT);
+}
+
+__attribute__((target("sse4.2"))) std::size_t findCrlfSse42(const char* data,
+                                                              std::size_t len) {
+  std::size_t i = 0;
+
+  for (; i + 17 <= len; i += 16) {
+    int mask = crlfMask16(data + i);
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+  std::size_t rest = findCrlfScalar(data + i, len - i);
+  return rest == npos ? npos : i + rest;
+}
+
+__attribute__((target("sse4.2"))) std::size_t tokenLengthSse42(
+    const char* data, std::size_t len) {
+  std::size_t i = 0;
+
+  for (; i + 16 <= len; i += 16) {
+    int mask = invalidTokenMask16(data + i);
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+  return i + tokenLengthScalar(data + i, len - i);
+}
+
+__attribute__((target("sse4.2"))) std::size_t fieldValueLengthSse42(
+    const char* data, std::size_t len) {
+  std::size_t i = 0;
+
+  for (; i + 16 <= len; i += 16) {
+    int idx = invalidValueIndex16(data + i);
+    if (idx != 16) return i + idx;
+  }
+  return i + fieldValueLengthScalar(data + i, len - i);
+}
+
+// ============================================================================
+// AVX2 (bloques de 32, luego uno de 16, luego escalar)
+// ============================================================================
+
+__attribute__((target("avx2"))) std::size_t findCrlfAvx2(const char* data,
+                                                           std::size_t len) {
+  const __m256i cr = _mm256_set1_epi8('\r');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  std::size_t i = 0;
+
+  // Se compara [i, i + 32) con '\r' y [i + 1, i + 33) con '\n'
+  for (; i + 33 <= len; i += 32) {
+    __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 1));
+    unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(a, cr), _mm256_cmpeq_epi8(b, lf))));
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+  if (i + 17 <= len) {
+    int mask = crlfMask16(data + i);
+    if (mask != 0) return i + __builtin_ctz(mask);
+    i += 16;
+  }
+  _mm256_zeroupper();
+  std::size_t rest = findCrlfScalar(data + i, len - i);
+  return rest == npos ? npos : i + rest;
+}
+
+__attribute__((target("avx2"))) std::size_t tokenLengthAvx2(const char* data,
+                                                              std::size_t len) {
+  const __m256i lo =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.tokenLo));
+  const __m256i hiBit =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.hiBit));
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  std::size_t i = 0;
+
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i loBits = _mm256_shuffle_epi8(lo, _mm256_and_si256(v, nibble));
+    __m256i hiBits = _mm256_shuffle_epi8(
+        hiBit, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    __m256i valid = _mm256_and_si256(loBits, hiBits);
+    unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(valid, _mm256_setzero_si256())));
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+  if (i + 16 <= len) {
+    int mask = invalidTokenMask16(data + i);
+    if (mask != 0) return i + __builtin_ctz(mask);
+    i += 16;
+  }
+  _mm256_zeroupper();
+  return i + tokenLengthScalar(data + i, len - i);
+}
+
+// Inválidos: 0x00-0x1f salvo '\t', y 0x7f. Con comparación con signo los
+// bytes >= 0x80 (obs-text, válidos) son negativos: se descartan aparte.
+__attribute__((target("avx2"))) std::size_t fieldValueLengthAvx2(
+    const char* data, std::size_t len) {
+  const __m256i space = _mm256_set1_epi8(0x20);
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i del = _mm256_set1_epi8(0x7f);
+  const __m256i zero = _mm256_setzero_si256();
+  std::size_t i = 0;
+
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i ctl = _mm256_andnot_si256(_mm256_cmpgt_epi8(zero, v),
+                                      _mm256_cmpgt_epi8(space, v));
+    ctl = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), ctl);
+    __m256i bad = _mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, del));
+    unsigned int mask =
+        static_cast<unsigned int>(_mm256_movemask_epi8(bad));
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+  if (i + 16 <= len) {
+    int idx = invalidValueIndex16(data + i);
+    if (idx != 16) return i + idx;
+    i += 16;
+  }
+  _mm256_zeroupper();
+  return i + fieldValueLengthScalar(data + i, len - i);
+}
+
+#endif  // HTTP_SCAN_X86
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+struct Kernels {
+  std::size_t (*findCrlf)(const char*, std::size_t);
+  std::size_t (*tokenLength)(const char*, std::size_t);
+  std::size_t (*fieldValueLength)(const char*, std::size_t);
+};
+
+const Kernels kernels[] = {
+    {findCrlfScalar, tokenLengthScalar, fieldValueLengthScalar},
+#ifdef HTTP_SCAN_X86
+    {findCrlfSse42, tokenLengthSse42, fieldValueLengthSse42},
+    {findCrlfAvx2, tokenLengthAvx2, fieldValueLengthAvx2},
+#endif
+};
+
+Level detectLevel() {
+#ifdef HTTP_SCAN_X86
+  // CPUID (libgcc); hace falta inicializarlo a mano antes de main()
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return LEVEL_AVX2;
+  if (__builtin_cpu_supports("sse4.2")) return LEVEL_SSE42;
+#endif
+  return LEVEL_SCALAR;
+}
+
+const Level best = detectLevel();
+Level active = best;
+const Kernels* current = &kernels[best];
+
+}  // namespace
+
+// ============================================================================
+// API
+// ============================================================================
+
+std::size_t findCrlf(const char* data, std::size_t len) {
+  return current->findCrlf(data, len);
+}
+
+std::size_t tokenLength(const char* data, std::size_t len) {
+  return current->tokenLength(data, len);
+}
+
+std::size_t fieldValueLength(const char* data, std::size_t len) {
+  return current->fieldValueLength(data, len);
+}
+
+Level bestLevel() { return best; }
+
+Level activeLevel() { return active; }
+
+void setLevel(Level level) {
+  if (level > best) level = best;
+  active = level;
+  current = &kernels[level];
+}
+
+const char* levelName(Level level) {
+  switch (level) {
+    case LEVEL_AVX2:
+      return "avx2";
+    case LEVEL_SSE42:
+      return "sse4.2";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace http_scan
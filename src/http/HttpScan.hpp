@@ -0,0 +1,37 @@
+#ifndef HTTP_SCAN_HPP
+#define HTTP_SCAN_HPP
+
+#include <cstddef>
+
+/**
+ * Búsquedas sobre el buffer de recepción que hace el parser en cada línea
+ * de la cabecera: fin de línea, token (método, nombre de header) y valor de
+ * header.
+ *
+ * Cada una tiene tres versiones: escalar, SSE4.2 (16 bytes por iteración) y
+ * AVX2 (32 bytes). La mejor que soporta la CPU se elige una vez al arrancar
+ * (CPUID); en otras arquitecturas solo existe la escalar.
+ */
+namespace http_scan {
+
+enum Level { LEVEL_SCALAR, LEVEL_SSE42, LEVEL_AVX2 };
+
+const std::size_t npos = static_cast<std::size_t>(-1);
+
+// Offset del primer "\r\n" en [data, data + len), o npos
+std::size_t findCrlf(const char* data, std::size_t len);
+// Longitud del prefijo formado por tchar (RFC 9110: método, nombre de header)
+std::size_t tokenLength(const char* data, std::size_t len);
+// Longitud del prefijo válido como valor de header: VCHAR, obs-text, SP, HTAB
+std::size_t fieldValueLength(const char* data, std::size_t len);
+
+// La que detectó CPUID, y la que se está usando
+Level bestLevel();
+Level activeLevel();
+// Para tests y benchmarks: fuerza una versión (nunca por encima de la CPU)
+void setLevel(Level level);
+const char* levelName(Level level);
+
+}  // namespace http_scan
+
+#endif  // HTTP_SCAN_HPP
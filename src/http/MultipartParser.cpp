@@ -0,0 +1,290 @@
+#include "MultipartParser.hpp"
+
+#include <cstring>
+
+#include "HttpHeaderUtils.hpp"
+#include "HttpScan.hpp"
+
+namespace {
+
+// Recorre los parámetros "; key=value" / "; key="quoted"" que siguen al
+// valor principal de un header (Content-Type, Content-Disposition)
+bool findParam(const std::string& header, const char* name,
+               std::string& value) {
+  std::size_t i = header.find(';');
+  while (i != std::string::npos && i < header.size()) {
+    ++i;  // ';'
+    while (i < header.size() && (header[i] == ' ' || header[i] == '\t')) ++i;
+    std::size_t keyStart = i;
+    while (i < header.size() && header[i] != '=' && header[i] != ';') ++i;
+    std::string key =
+        http_header_utils::trimSpaces(header.substr(keyStart, i - keyStart));
+    if (i >= header.size() || header[i] == ';') continue;  // sin valor
+    ++i;  // '='
+
+    std::string raw;
+    if (i < header.size() && header[i] == '"') {
+      for (++i; i < header.size() && header[i] != '"'; ++i) {
+        if (header[i] == '\\' && i + 1 < header.size()) ++i;
+        raw += header[i];
+      }
+      if (i < header.size()) ++i;  // '"' final
+      while (i < header.size() && header[i] != ';') ++i;
+    } else {
+      std::size_t valueStart = i;
+      while (i < header.size() && header[i] != ';') ++i;
+      raw = http_header_utils::trimSpaces(
+          header.substr(valueStart, i - valueStart));
+    }
+    if (http_header_utils::equalsIgnoreCase(key.data(), key.size(), name)) {
+      value = raw;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Valor principal de un header, antes del primer ';'
+std::string mainValue(const std::string& header) {
+  return http_header_utils::trimSpaces(header.substr(0, header.find(';')));
+}
+
+}  // namespace
+
+MultipartParser::MultipartParser(const std::string& boundary,
+                                 MultipartHandler& handler)
+    : delimiter_("\r\n--" + boundary),
+      handler_(handler),
+      phase_(PREAMBLE),
+      malformed_(false),
+      // El primer delimitador no lleva "\r\n" delante: se hace como si lo
+      // llevara, así se busca igual que los demás
+      pending_("\r\n"),
+      afterDelimiter_() {}
+
+MultipartParser::~MultipartParser() {}
+
+bool MultipartParser::isDone() const { return phase_ == EPILOGUE; }
+
+bool MultipartParser::hasError() const { return malformed_; }
+
+bool MultipartParser::boundaryFrom(const std::string& contentType,
+                                   std::string& boundary) {
+  std::string type = mainValue(contentType);
+  if (!http_header_utils::equalsIgnoreCase(type.data(), type.size(),
+                                           "multipart/form-data"))
+    return false;
+  if (!findParam(contentType, "boundary", boundary)) return false;
+  if (boundary.empty() || boundary.size() > MAX_BOUNDARY) return false;
+  // El delimitador no puede contener "\r": así un "\r" solo puede ser su
+  // primer byte (findDelimiter depende de ello)
+  return boundary.find_first_of("\r\n") == std::string::npos;
+}
+
+bool MultipartParser::feed(const char* data, std::size_t len) {
+  while (len > 0) {
+    switch (phase_) {
+      case PREAMBLE:
+      case PART_DATA:
+        if (!scanBody(data, len)) return false;
+        break;
+      case AFTER_DELIMITER:
+        if (!parseAfterDelimiter(data, len)) return false;
+        break;
+      case PART_HEADERS:
+        if (!parsePartHeaders(data, len)) return false;
+        break;
+      case EPILOGUE:
+      case FAILED:
+        return phase_ != FAILED || malformed_;
+    }
+  }
+  return true;
+}
+
+void MultipartParser::fail() {
+  phase_ = FAILED;
+  malformed_ = true;
+  pending_.clear();
+}
+
+bool MultipartParser::emit(const char* data, std::size_t len) {
+  if (phase_ != PART_DATA || len == 0) return true;  // preámbulo: se descarta
+  if (handler_.onPartData(data, len)) return true;
+  phase_ = FAILED;
+  return false;
+}
+
+// Offset del delimitador completo en [data, data + len), o npos. Si no está
+// pero el final de data coincide con su principio, partial = esos bytes.
+std::size_t MultipartParser::findDelimiter(const char* data, std::size_t len,
+                                           std::size_t& partial) const {
+  const std::size_t size = delimiter_.size();
+  std::size_t i = 0;
+
+  partial = 0;
+  while (i < len) {
+    std::size_t crlf = http_scan::findCrlf(data + i, len - i);
+    if (crlf == http_scan::npos) {
+      if (data[len - 1] == '\r') partial = 1;
+      return http_scan::npos;
+    }
+    std::size_t at = i + crlf;
+    std::size_t avail = len - at;
+    if (avail >= size) {
+      if (std::memcmp(data + at, delimiter_.data(), size) == 0) return at;
+    } else if (std::memcmp(data + at, delimiter_.data(), avail) == 0) {
+      partial = avail;
+      return http_scan::npos;
+    }
+    i = at + 1;
+  }
+  return http_scan::npos;
+}
+
+// Preámbulo o datos de una parte, hasta el siguiente delimitador
+bool MultipartParser::scanBody(const char*& data, std::size_t& len) {
+  // Bytes del trozo anterior que podían ser el principio del delimitador
+  if (!pending_.empty()) {
+    std::size_t have = pending_.size();
+    std::size_t need = delimiter_.size() - have;
+    std::size_t n = need < len ? need : len;
+
+    if (std::memcmp(data, delimiter_.data() + have, n) != 0) {
+      // No lo eran: son datos. Ninguno de ellos puede empezar otro
+      // delimitador (el único "\r" está en pending_[0])
+      std::string kept;
+      kept.swap(pending_);
+      if (!emit(kept.data(), kept.size())) return false;
+    } else if (n < need) {
+      pending_.append(data, n);
+      data += n;
+      len -= n;
+      return true;
+    } else {
+      pending_.clear();
+      data += n;
+      len -= n;
+      if (phase_ == PART_DATA && !handler_.onPartEnd()) {
+        phase_ = FAILED;
+        return false;
+      }
+      phase_ = AFTER_DELIMITER;
+      afterDelimiter_.clear();
+      return true;
+    }
+  }
+
+  std::size_t partial = 0;
+  std::size_t at = findDelimiter(data, len, partial);
+  if (at == http_scan::npos) {
+    if (!emit(data, len - partial)) return false;
+    pending_.assign(data + len - partial, partial);
+    data += len;
+    len = 0;
+    return true;
+  }
+
+  if (!emit(data, at)) return false;
+  data += at + delimiter_.size();
+  len -= at + delimiter_.size();
+  if (phase_ == PART_DATA && !handler_.onPartEnd()) {
+    phase_ = FAILED;
+    return false;
+  }
+  phase_ = AFTER_DELIMITER;
+  afterDelimiter_.clear();
+  return true;
+}
+
+// Tras "--boundary": "--" cierra el body; si no, espacios opcionales y
+// "\r\n" antes de las cabeceras de la siguiente parte
+bool MultipartParser::parseAfterDelimiter(const char*& data,
+                                          std::size_t& len) {
+  while (len > 0) {
+    char c = *data++;
+    --len;
+    afterDelimiter_ += c;
+
+    if (afterDelimiter_ == "--") {
+      phase_ = EPILOGUE;
+      return true;
+    }
+    if (afterDelimiter_ == "-") continue;
+
+    std::size_t n = afterDelimiter_.size();
+    if (c == '\n' && n >= 2 && afterDelimiter_[n - 2] == '\r') {
+      phase_ = PART_HEADERS;
+      pending_ = "\r\n";  // las cabeceras se buscan hasta "\r\n\r\n"
+      return true;
+    }
+    bool blank = (c == ' ' || c == '\t') && afterDelimiter_[0] != '-';
+    if ((!blank && c != '\r') || n > 64) {
+      fail();
+      return true;
+    }
+  }
+  return true;
+}
+
+bool MultipartParser::parsePartHeaders(const char*& data, std::size_t& len) {
+  std::size_t old = pending_.size();
+  std::size_t room = MAX_PART_HEADER + 4 - old;
+  std::size_t take = len < room ? len : room;
+
+  pending_.append(data, take);
+  std::size_t end = pending_.find("\r\n\r\n", old >= 3 ? old - 3 : 0);
+  if (end == std::string::npos) {
+    data += take;
+    len -= take;
+    if (pending_.size() >= MAX_PART_HEADER + 4) fail();
+    return true;
+  }
+
+  std::size_t used = end + 4 - old;
+  data += used;
+  len -= used;
+  pending_.resize(end + 4);  // lo que sigue ya son datos de la parte
+
+  MultipartPart part;
+  if (!parseHeaderBlock(part)) {
+    fail();
+    return true;
+  }
+  pending_.clear();
+  phase_ = PART_DATA;
+  if (handler_.onPartBegin(part)) return true;
+  phase_ = FAILED;
+  return false;
+}
+
+// pending_ = "\r\n" + líneas de cabecera + "\r\n\r\n"
+bool MultipartParser::parseHeaderBlock(MultipartPart& part) const {
+  std::size_t end = pending_.size() - 4;
+  std::size_t pos = 2;
+
+  while (pos < end) {
+    std::size_t eol = pending_.find("\r\n", pos);
+    std::string line = pending_.substr(pos, eol - pos);
+    pos = eol + 2;
+    if (line.empty()) continue;
+
+    std::string key;
+    std::string value;
+    if (!http_header_utils::splitHeaderLine(line, key, value)) return false;
+
+    if (http_header_utils::equalsIgnoreCase(key.data(), key.size(),
+                                            "content-disposition")) {
+      std::string type = mainValue(value);
+      if (!http_header_utils::equalsIgnoreCase(type.data(), type.size(),
+                                               "form-data"))
+        return false;
+      findParam(value, "name", part.name);
+      part.hasFilename = findParam(value, "filename", part.filename);
+    } else if (http_header_utils::equalsIgnoreCase(key.data(), key.size(),
+                                                   "content-type")) {
+      part.contentType = value;
+    }
+  }
+  return true;
+}
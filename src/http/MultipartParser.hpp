@@ -0,0 +1,89 @@
+#ifndef MULTIPART_PARSER_HPP
+#define MULTIPART_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+
+// Cabeceras de una parte de multipart/form-data que interesan
+struct MultipartPart {
+  std::string name;      // Content-Disposition: name="..."
+  std::string filename;  // Content-Disposition: filename="..."
+  bool hasFilename;      // es un fichero (aunque el nombre venga vacío)
+  std::string contentType;
+  MultipartPart() : hasFilename(false) {}
+};
+
+// Lo que hace cada caller con las partes (ej: FormUpload las escribe en
+// upload_store). Devolver false aborta el parseo (error de E/S).
+class MultipartHandler {
+ public:
+  virtual ~MultipartHandler() {}
+  virtual bool onPartBegin(const MultipartPart& part) = 0;
+  virtual bool onPartData(const char* data, std::size_t len) = 0;
+  virtual bool onPartEnd() = 0;
+};
+
+/**
+ * @brief Parser incremental de multipart/form-data (RFC 7578 / RFC 2046).
+ *
+ * feed() recibe el body en trozos de cualquier tamaño, tal como llega del
+ * socket, y entrega los datos de cada parte al handler sin acumularlos: solo
+ * se guardan las cabeceras de la parte en curso (MAX_PART_HEADER) y, entre
+ * dos trozos, los pocos bytes finales que podrían ser el principio de un
+ * delimitador.
+ *
+ * El delimitador es "\r\n--boundary". Se busca con http_scan::findCrlf
+ * (SSE4.2/AVX2 según la CPU) y se confirma con memcmp donde aparece un
+ * "\r\n": en datos binarios casi nunca hay uno, así que se recorre a
+ * velocidad de vector.
+ */
+class MultipartParser {
+ public:
+  static const std::size_t MAX_PART_HEADER = 8192;
+  static const std::size_t MAX_BOUNDARY = 70;  // RFC 2046
+
+  MultipartParser(const std::string& boundary, MultipartHandler& handler);
+  ~MultipartParser();
+
+  // false si el handler falló; un body mal formado no devuelve false, deja
+  // de procesarse (hasError()) y el resto se ignora
+  bool feed(const char* data, std::size_t len);
+
+  bool isDone() const;    // se leyó el delimitador final "--boundary--"
+  bool hasError() const;  // body mal formado
+
+  // boundary del header Content-Type: multipart/form-data; boundary=...
+  static bool boundaryFrom(const std::string& contentType,
+                           std::string& boundary);
+
+ private:
+  enum Phase {
+    PREAMBLE,        // antes del primer delimitador (se descarta)
+    AFTER_DELIMITER,  // "--" (fin) o espacios + "\r\n" (otra parte)
+    PART_HEADERS,
+    PART_DATA,
+    EPILOGUE,  // después de "--boundary--" (se descarta)
+    FAILED
+  };
+
+  std::string delimiter_;  // "\r\n--" + boundary
+  MultipartHandler& handler_;
+  Phase phase_;
+  bool malformed_;
+  std::string pending_;  // prefijo de delimitador, o cabeceras en curso
+  std::string afterDelimiter_;
+
+  bool scanBody(const char*& data, std::size_t& len);
+  bool emit(const char* data, std::size_t len);
+  std::size_t findDelimiter(const char* data, std::size_t len,
+                            std::size_t& partial) const;
+  bool parseAfterDelimiter(const char*& data, std::size_t& len);
+  bool parsePartHeaders(const char*& data, std::size_t& len);
+  bool parseHeaderBlock(MultipartPart& part) const;
+  void fail();
+
+  MultipartParser(const MultipartParser&);
+  MultipartParser& operator=(const MultipartParser&);
+};
+
+#endif  // MULTIPART_PARSER_HPP
@@ -0,0 +1,231 @@
+#include "RequestBody.hpp"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "FormUpload.hpp"
+
+namespace {
+
+const char* const TEMP_DIR = "/tmp";
+
+// Fichero sin nombre: O_TMPFILE (Linux >= 3.11) o, si el fs no lo soporta,
+// mkostemp + unlink. O_CLOEXEC: los CGI de otros reactores no lo heredan.
+int openTempFile() {
+#ifdef O_TMPFILE
+  int fd = open(TEMP_DIR, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+  if (fd >= 0) return fd;
+#endif
+  char path[] = "/tmp/webserv-body-XXXXXX";
+  int tmp = mkostemp(path, O_CLOEXEC);
+  if (tmp >= 0) unlink(path);
+  return tmp;
+}
+
+pthread_once_t uploadModeOnce = PTHREAD_ONCE_INIT;
+mode_t uploadMode = 0644;
+
+// umask no se puede leer sin cambiarla, y con worker_threads otro hilo
+// podría crear un fichero justo entonces: se lee de /proc (Linux >= 4.7)
+// y solo si no está se hace el umask(0) + umask(mask).
+void readUploadMode() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "Umask:") != 0) continue;
+    uploadMode = 0666 & ~static_cast<mode_t>(
+                            std::strtol(line.c_str() + 6, NULL, 8));
+    return;
+  }
+  mode_t mask = umask(0);
+  umask(mask);
+  uploadMode = 0666 & ~mask;
+}
+
+}  // namespace
+
+int RequestBody::createUploadFile(const std::string& dir, std::string& path) {
+  std::string pattern = dir;
+  if (pattern.empty() || pattern[pattern.size() - 1] != '/') pattern += '/';
+  pattern += ".upload-XXXXXX";
+  std::vector<char> name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  int fd = mkostemp(&name[0], O_CLOEXEC);
+  if (fd < 0) return -1;
+  // mkostemp crea con 0600; el fichero subido tiene los permisos de un
+  // open(..., 0666) normal
+  pthread_once(&uploadModeOnce, readUploadMode);
+  if (fchmod(fd, uploadMode) != 0) {
+    close(fd);
+    unlink(&name[0]);
+    return -1;
+  }
+  path.assign(&name[0]);
+  return fd;
+}
+
+RequestBody::RequestBody()
+    : memory_(), limit_(NO_LIMIT), size_(0), fd_(-1), storedPath_(), form_(NULL) {}
+
+RequestBody::RequestBody(const RequestBody& other)
+    : memory_(other.memory_),
+      limit_(other.limit_),
+      size_(other.size_),
+      fd_(other.fd_ >= 0 ? fcntl(other.fd_, F_DUPFD_CLOEXEC, 0) : -1),
+      storedPath_(),
+      form_(NULL) {}
+
+RequestBody& RequestBody::operator=(const RequestBody& other) {
+  if (this != &other) {
+    closeFile();
+    memory_ = other.memory_;
+    limit_ = other.limit_;
+    size_ = other.size_;
+    if (other.fd_ >= 0) fd_ = fcntl(other.fd_, F_DUPFD_CLOEXEC, 0);
+  }
+  return *this;
+}
+
+RequestBody::~RequestBody() { closeFile(); }
+
+void RequestBody::setMemoryLimit(std::size_t bytes) { limit_ = bytes; }
+
+bool RequestBody::append(const char* data, std::size_t len) {
+  if (len == 0) return true;
+  if (form_) {
+    if (!form_->write(data, len)) return false;
+    size_ += len;
+    return true;
+  }
+  if (fd_ < 0 && size_ + len > limit_ && !spill()) return false;
+
+  if (fd_ >= 0) {
+    if (!writeFile(size_, data, len)) return false;
+  } else {
+    memory_.insert(memory_.end(), data, data + len);
+  }
+  size_ += len;
+  return true;
+}
+
+bool RequestBody::storeIn(const std::string& dir, std::size_t expected) {
+  if (size_ != 0 || fd_ >= 0 || form_) return false;
+
+  std::string path;
+  int fd = createUploadFile(dir, path);
+  if (fd < 0) return false;
+  // Reserva los bloques ya: sin fragmentar el fichero mientras llega, y un
+  // disco lleno se nota aquí. Si el fs no lo soporta se sigue sin reservar.
+  if (expected > 0 && fallocate(fd, 0, 0, static_cast<off_t>(expected)) != 0 &&
+      errno == ENOSPC) {
+    close(fd);
+    unlink(path.c_str());
+    return false;
+  }
+  fd_ = fd;
+  storedPath_ = path;
+  return true;
+}
+
+const std::string& RequestBody::storedPath() const { return storedPath_; }
+
+bool RequestBody::commitTo(const std::string& path) const {
+  if (storedPath_.empty() || rename(storedPath_.c_str(), path.c_str()) != 0)
+    return false;
+  storedPath_.clear();
+  return true;
+}
+
+bool RequestBody::storeFormIn(const std::string& dir,
+                              const std::string& boundary) {
+  if (size_ != 0 || fd_ >= 0 || form_) return false;
+  form_ = new FormUpload(dir, boundary);
+  return true;
+}
+
+FormUpload* RequestBody::form() const { return form_; }
+
+bool RequestBody::spill() {
+  fd_ = openTempFile();
+  if (fd_ < 0) return false;
+  if (!memory_.empty() && !writeFile(0, &memory_[0], memory_.size())) {
+    closeFile();
+    return false;
+  }
+  // swap: clear() no devolvería la memoria
+  std::vector<char>().swap(memory_);
+  return true;
+}
+
+// Escribe en offset, reintentando escrituras parciales
+bool RequestBody::writeFile(std::size_t offset, const char* data,
+                            std::size_t len) {
+  std::size_t done = 0;
+  while (done < len) {
+    ssize_t n = pwrite(fd_, data + done, len - done,
+                       static_cast<off_t>(offset + done));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    done += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+std::size_t RequestBody::size() const { return size_; }
+
+bool RequestBody::empty() const { return size_ == 0; }
+
+bool RequestBody::isInFile() const { return fd_ >= 0; }
+
+const char* RequestBody::data() const {
+  return (fd_ < 0 && !memory_.empty()) ? &memory_[0] : NULL;
+}
+
+int RequestBody::fd() const { return fd_; }
+
+std::size_t RequestBody::read(std::size_t offset, char* dst,
+                              std::size_t len) const {
+  if (offset >= size_ || form_) return 0;
+  if (len > size_ - offset) len = size_ - offset;
+
+  if (fd_ < 0) {
+    std::memcpy(dst, &memory_[offset], len);
+    return len;
+  }
+  while (true) {
+    ssize_t n = pread(fd_, dst, len, static_cast<off_t>(offset));
+    if (n >= 0) return static_cast<std::size_t>(n);
+    if (errno != EINTR) return 0;
+  }
+}
+
+void RequestBody::clear() {
+  closeFile();
+  memory_.clear();
+  size_ = 0;
+}
+
+void RequestBody::closeFile() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  // Upload sin terminar: no dejar el temporal en upload_store
+  if (!storedPath_.empty()) {
+    unlink(storedPath_.c_str());
+    storedPath_.clear();
+  }
+  delete form_;  // borra los ficheros del formulario sin commit()
+  form_ = NULL;
+}
@@ -0,0 +1,97 @@
+#ifndef REQUEST_BODY_HPP
+#define REQUEST_BODY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class FormUpload;
+
+/**
+ * @brief Body de una petición: en memoria mientras es pequeño, en un
+ * fichero temporal cuando supera client_body_buffer_size.
+ *
+ * - Hasta el límite los bytes van a un vector (como antes).
+ * - Al superarlo se abre un fichero anónimo (O_TMPFILE en /tmp, o mkstemp +
+ *   unlink si el kernel/fs no lo soporta), se vuelca lo que había en memoria,
+ *   se libera el vector y el resto del body se escribe directamente ahí.
+ * - El fichero se escribe y se lee con pwrite/pread: el offset del
+ *   descriptor no se usa, así un CGI puede heredarlo como stdin.
+ * - Al cerrarlo (clear(), destructor) el kernel borra el fichero.
+ * - Un upload puede guardarse desde el primer byte en un fichero con nombre
+ *   dentro de upload_store (storeIn); al terminar se renombra al destino
+ *   (commitTo), sin copiar nada. Si la petición no llega a completarse ese
+ *   fichero se borra.
+ * - Si es multipart/form-data (storeFormIn) los bytes van a un FormUpload
+ *   que escribe cada fichero del formulario en upload_store según llega; el
+ *   body en sí no se guarda (size() cuenta los bytes, read() no da nada).
+ *
+ * Así la memoria por conexión queda acotada por el límite, da igual el tamaño
+ * del upload.
+ */
+class RequestBody {
+ public:
+  static const std::size_t NO_LIMIT = static_cast<std::size_t>(-1);
+
+  RequestBody();
+  RequestBody(const RequestBody& other);  // comparte el fichero (dup)
+  RequestBody& operator=(const RequestBody& other);
+  ~RequestBody();
+
+  // Bytes que se guardan en memoria antes de pasar a fichero (NO_LIMIT por
+  // defecto). No afecta a un body que ya está en fichero.
+  void setMemoryLimit(std::size_t bytes);
+
+  // false si no se pudo crear o escribir el fichero temporal
+  bool append(const char* data, std::size_t len);
+
+  // Solo antes del primer byte: el body se escribirá en un fichero temporal
+  // de dir (mismo filesystem que el destino final). expected > 0 reserva ese
+  // espacio de antemano (fallocate); 0 si no hay max_body_size que lo acote.
+  // false: se sigue como antes.
+  bool storeIn(const std::string& dir, std::size_t expected);
+  // Fichero de storeIn() pendiente de commitTo(), vacío si no hay
+  const std::string& storedPath() const;
+  // rename() atómico del fichero de storeIn() a path. El contenido no
+  // cambia, por eso es const: solo deja de borrarse al cerrar.
+  bool commitTo(const std::string& path) const;
+  // Como storeIn(), pero el body se parsea como multipart/form-data con ese
+  // boundary y se guardan solo sus ficheros
+  bool storeFormIn(const std::string& dir, const std::string& boundary);
+  // Upload de storeFormIn(), NULL si no hay. Se devuelve sin const (igual
+  // que commitTo): commit() no cambia el body, solo quién borra los ficheros
+  FormUpload* form() const;
+
+  // Temporal .upload-XXXXXX en dir, con los permisos de un open(0666)
+  // normal (0666 & ~umask) para que rename() lo deje listo. -1 si falla.
+  static int createUploadFile(const std::string& dir, std::string& path);
+
+  std::size_t size() const;
+  bool empty() const;
+  bool isInFile() const;
+  // Solo con el body en memoria (NULL si está en fichero o vacío)
+  const char* data() const;
+  // Descriptor del fichero temporal, -1 si está en memoria
+  int fd() const;
+  // Copia hasta len bytes desde offset, esté donde esté; devuelve los bytes
+  // copiados (0 al final o si falla la lectura)
+  std::size_t read(std::size_t offset, char* dst, std::size_t len) const;
+
+  void clear();  // vuelve a memoria, mantiene el límite
+
+ private:
+  std::vector<char> memory_;
+  std::size_t limit_;
+  std::size_t size_;
+  int fd_;  // -1 mientras el body está en memoria
+  // storeIn(): nombre del fichero, se borra en clear() salvo tras commitTo().
+  // Las copias no lo heredan (no son dueñas del fichero).
+  mutable std::string storedPath_;
+  FormUpload* form_;  // storeFormIn(); tampoco pasa a las copias
+
+  bool spill();  // memory_ -> fichero temporal
+  bool writeFile(std::size_t offset, const char* data, std::size_t len);
+  void closeFile();
+};
+
+#endif  // REQUEST_BODY_HPP
@@ -6,13 +6,19 @@
 
 #include "common/namespaces.hpp"
 #include "config/ConfigException.hpp"
-#include "config/ConfigParser.hpp"
+#include "config/ConfigStore.hpp"
 #include "config/ConfigUtils.hpp"
 #include "config/ConfigUtils.hpp"
+#include "network/ReactorPool.hpp"
 #include "network/ServerManager.hpp"
+#include "network/WorkerSupervisor.hpp"
 
-// Global flag to control the main server loop
-bool g_running = true;
+// Global flag to control the main server loop (every reactor thread reads it)
+volatile sig_atomic_t g_running = 1;
+// SIGHUP counter, compared by every reactor against the last one it handled
+volatile sig_atomic_t g_reload_requests = 0;
+// Only ever set inside a retired worker process (see WorkerSupervisor)
+volatile sig_atomic_t g_draining = 0;
 
 /**
  * Signal handler for SIGINT (Ctrl+C) and SIGTERM.
@@ -21,7 +27,16 @@ bool g_running = true;
 void handle_signal(int sig) {
   (void)sig; // Suppress unused parameter warning
   std::cout << "\n[Signal " << sig << "] Stopping server gracefully..." << std::endl;
-  g_running = false;
+  g_running = 0;
+}
+
+/**
+ * Signal handler for SIGHUP: asks for a configuration reload.
+ * Parsing is not async-signal-safe, the reactors do it on their next loop.
+ */
+void handle_reload(int sig) {
+  (void)sig;
+  g_reload_requests = g_reload_requests + 1;
 }
 
 /**
@@ -66,16 +81,37 @@ int main(int argc, char* argv[]) {
   signal(SIGINT, handle_signal);
   signal(SIGQUIT, handle_signal);
   signal(SIGTERM, handle_signal);
+  signal(SIGHUP, handle_reload);
 
   try {
-    ConfigParser parser(configPath);
-    std::cout << "Config file path: [" << config::colors::blue
-              << parser.getConfigFilePath() << "]\n"
+    std::cout << "Config file path: [" << config::colors::blue << configPath
+              << "]\n"
               << config::colors::reset;
-    parser.parse();
+    // Parsed now, and again on every SIGHUP
+    ConfigStore store(configPath);
+
+    ConfigSnapshot* initial = store.acquire();
+    const GlobalConfig global = initial->getGlobalConfig();
+    initial->release();
+
+    // worker_processes > 1: master binds once and supervises forked workers
+    if (global.getWorkerProcesses() > 1) {
+      WorkerSupervisor master(&store);
+      master.run();
+      std::flush(std::cout);
+      return 0;
+    }
+
+    // worker_threads > 1: one independent reactor per thread
+    if (global.getWorkerThreads() > 1) {
+      ReactorPool pool(&store);
+      pool.run();
+      std::flush(std::cout);
+      return 0;
+    }
 
     // Create the server manager with the list of server configurations.
-    ServerManager server(&parser.getServers());
+    ServerManager server(&store);
 
     /**
      * Start the server(s).
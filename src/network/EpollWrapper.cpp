@@ -2,12 +2,14 @@
 
 #include <cerrno>
 #include <iostream>
+#include <stdexcept>
 
 int EpollWrapper::getFd() const { return epoll_fd_; }
 
 EpollWrapper::EpollWrapper() {
-  // epoll_create(size) size is ignored in modern kernels but must be > 0.
-  epoll_fd_ = epoll_create(1);
+  // EPOLL_CLOEXEC: with worker_threads every reactor has its own instance,
+  // none of them may leak into a CGI forked by any reactor.
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
   if (epoll_fd_ == -1) {
     throw std::runtime_error("Failed to create epoll instance");
   }
@@ -29,9 +31,15 @@ void EpollWrapper::addFd(int fd, uint32_t events) {
   if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == -1) {
     throw std::runtime_error("Failed to add fd to epoll");
   }
+  if (static_cast<size_t>(fd) >= masks_.size()) masks_.resize(fd + 1, 0);
+  masks_[fd] = events;
 }
 
 void EpollWrapper::modFd(int fd, uint32_t events) {
+  if (static_cast<size_t>(fd) < masks_.size() && masks_[fd] == events) {
+    return;
+  }
+
   epoll_event ev;
   ev.events = events;
   ev.data.fd = fd;
@@ -39,9 +47,12 @@ void EpollWrapper::modFd(int fd, uint32_t events) {
   if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) == -1) {
     throw std::runtime_error("Failed to modify fd in epoll");
   }
+  if (static_cast<size_t>(fd) >= masks_.size()) masks_.resize(fd + 1, 0);
+  masks_[fd] = events;
 }
 
 void EpollWrapper::removeFd(int fd) {
+  if (static_cast<size_t>(fd) < masks_.size()) masks_[fd] = 0;
   if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, NULL) == -1) {
     std::cerr << "Warning: Failed to remove fd from epoll" << std::endl;
   }
@@ -58,3 +69,7 @@ int EpollWrapper::wait(epoll_event* events, int maxevents, int timeout) {
   }
   return num_events;
 }
+
+bool EpollWrapper::supportsEdgeTriggered() const { return true; }
+
+const char* EpollWrapper::name() const { return "epoll"; }
@@ -4,23 +4,35 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
-class EpollWrapper {
+#include <vector>
+
+#include "EventBackend.hpp"
+
+class EpollWrapper : public EventBackend {
  public:
   EpollWrapper();
   ~EpollWrapper();
 
   void addFd(int fd, uint32_t events);
+  // No-op when the fd is already registered with exactly these events.
   void modFd(int fd, uint32_t events);
 
   void removeFd(int fd);
 
   int wait(epoll_event* events, int maxevents, int timeout);
 
+  bool supportsEdgeTriggered() const;
+  const char* name() const;
+
   int getFd() const;
 
  private:
   int epoll_fd_;
 
+  // Interest mask currently registered for each fd (indexed by fd, 0 = none).
+  // Lets modFd() skip the epoll_ctl syscall when the mask did not change.
+  std::vector<uint32_t> masks_;
+
   // Disable copying
   EpollWrapper(const EpollWrapper&);
   EpollWrapper& operator=(const EpollWrapper&);
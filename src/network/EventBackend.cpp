@@ -0,0 +1,20 @@
+#include "EventBackend.hpp"
+
+#include <exception>
+#include <iostream>
+
+#include "EpollWrapper.hpp"
+#include "IoUringPoller.hpp"
+#include "common/namespaces.hpp"
+
+EventBackend* EventBackend::create(const std::string& preferred) {
+  if (preferred == config::section::backend_io_uring) {
+    try {
+      return new IoUringPoller();
+    } catch (const std::exception& e) {
+      std::cerr << "io_uring unavailable (" << e.what()
+                << "), falling back to epoll" << std::endl;
+    }
+  }
+  return new EpollWrapper();
+}
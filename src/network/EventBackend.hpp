@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <string>
+
+/**
+ * @brief Readiness notification interface used by ServerManager.
+ *
+ * Events are described with the epoll vocabulary (EPOLLIN, EPOLLOUT,
+ * EPOLLRDHUP, EPOLLERR, EPOLLHUP share their values with poll(2)), so every
+ * backend fills the same epoll_event array and the dispatch code does not
+ * care which one is running.
+ *
+ * Implementations:
+ * - EpollWrapper: default, always available.
+ * - IoUringPoller: io_uring POLL_ADD based; falls back to epoll when the
+ *   kernel (or a seccomp policy) does not allow io_uring.
+ */
+class EventBackend {
+ public:
+  virtual ~EventBackend() {}
+
+  virtual void addFd(int fd, uint32_t events) = 0;
+  virtual void modFd(int fd, uint32_t events) = 0;
+  virtual void removeFd(int fd) = 0;
+
+  // Returns the number of events written to `events` (0 on timeout/EINTR)
+  virtual int wait(epoll_event* events, int maxevents, int timeout) = 0;
+
+  // EPOLLET semantics (edge_triggered on) are only offered by epoll
+  virtual bool supportsEdgeTriggered() const = 0;
+  virtual const char* name() const = 0;
+
+  // Builds the preferred backend ("epoll" or "io_uring"), falling back to
+  // epoll if it cannot be initialised. Caller owns the result.
+  static EventBackend* create(const std::string& preferred);
+};
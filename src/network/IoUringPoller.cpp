@@ -0,0 +1,346 @@
+#include "IoUringPoller.hpp"
+
+#include <stdexcept>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define WEBSERV_HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef WEBSERV_HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// user_data = (generation << 32) | fd. Generations are 31 bit so the tag
+// below can never collide with a poll completion.
+const uint64_t REMOVE_TAG = ~static_cast<uint64_t>(0);
+const uint32_t GENERATION_MASK = 0x7fffffffu;
+
+// Bits poll(2) does not understand: the backend is always level triggered
+const uint32_t UNSUPPORTED_EVENTS = EPOLLET | EPOLLEXCLUSIVE | EPOLLONESHOT;
+
+int sysSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sysEnter(int ring_fd, unsigned to_submit, unsigned min_complete,
+             unsigned flags, const void* arg, size_t argsz) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, arg, argsz));
+}
+
+int sysRegister(int ring_fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+uint64_t makeUserData(int fd, uint32_t generation) {
+  return (static_cast<uint64_t>(generation) << 32) |
+         static_cast<uint32_t>(fd);
+}
+
+}  // namespace
+
+IoUringPoller::IoUringPoller()
+    : ring_fd_(-1),
+      sq_ptr_(MAP_FAILED),
+      sq_size_(0),
+      sq_head_(0),
+      sq_tail_(0),
+      sq_mask_(0),
+      sq_array_(0),
+      sqes_(MAP_FAILED),
+      sqes_size_(0),
+      cq_ptr_(MAP_FAILED),
+      cq_size_(0),
+      cq_head_(0),
+      cq_tail_(0),
+      cq_mask_(0),
+      cqes_(0) {
+  try {
+    setupRing();
+    probeOpcodes();
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+IoUringPoller::~IoUringPoller() { release(); }
+
+void IoUringPoller::release() {
+  if (sqes_ != MAP_FAILED) munmap(sqes_, sqes_size_);
+  if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+  if (sq_ptr_ != MAP_FAILED) munmap(sq_ptr_, sq_size_);
+  if (ring_fd_ != -1) close(ring_fd_);
+  sqes_ = cq_ptr_ = sq_ptr_ = MAP_FAILED;
+  ring_fd_ = -1;
+}
+
+/*
+ * @brief Create the ring and map the SQ/CQ rings and the SQE array.
+ *
+ * The wait timeout travels in io_uring_getevents_arg (IORING_FEAT_EXT_ARG,
+ * Linux 5.11+) so no TIMEOUT SQE has to be queued and cancelled per wait.
+ */
+void IoUringPoller::setupRing() {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  ring_fd_ = sysSetup(RING_ENTRIES, &params);
+  if (ring_fd_ < 0) {
+    ring_fd_ = -1;
+    throw std::runtime_error(std::string("io_uring_setup failed: ") +
+                             std::strerror(errno));
+  }
+  if (!(params.features & IORING_FEAT_EXT_ARG)) {
+    throw std::runtime_error("io_uring: kernel lacks IORING_FEAT_EXT_ARG");
+  }
+
+  sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap && cq_size_ > sq_size_) sq_size_ = cq_size_;
+
+  sq_ptr_ = mmap(0, sq_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ptr_ == MAP_FAILED) throw std::runtime_error("io_uring: mmap SQ");
+
+  if (single_mmap) {
+    cq_ptr_ = sq_ptr_;
+  } else {
+    cq_ptr_ = mmap(0, cq_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ptr_ == MAP_FAILED) throw std::runtime_error("io_uring: mmap CQ");
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = mmap(0, sqes_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) throw std::runtime_error("io_uring: mmap SQEs");
+
+  char* sq = static_cast<char*>(sq_ptr_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* cq = static_cast<char*>(cq_ptr_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+
+  // Ring slot i always points to SQE i
+  for (unsigned i = 0; i < params.sq_entries; ++i) sq_array_[i] = i;
+}
+
+void IoUringPoller::probeOpcodes() {
+  size_t len = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+  io_uring_probe* probe = static_cast<io_uring_probe*>(std::calloc(1, len));
+  if (probe == 0) throw std::runtime_error("io_uring: probe allocation");
+
+  int ret = sysRegister(ring_fd_, IORING_REGISTER_PROBE, probe, 256);
+  bool ok = ret >= 0 && probe->last_op >= IORING_OP_POLL_REMOVE &&
+            (probe->ops[IORING_OP_POLL_ADD].flags & IO_URING_OP_SUPPORTED) &&
+            (probe->ops[IORING_OP_POLL_REMOVE].flags & IO_URING_OP_SUPPORTED);
+  std::free(probe);
+  if (!ok) throw std::runtime_error("io_uring: POLL_ADD/POLL_REMOVE missing");
+}
+
+unsigned IoUringPoller::unsubmitted() const {
+  return *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * @brief Submit what is queued and optionally wait for completions.
+ *
+ * timeout follows epoll_wait(): -1 blocks, 0 only submits.
+ * Returns -1 only on hard errors; EINTR and ETIME count as "no wait".
+ */
+int IoUringPoller::enter(unsigned min_complete, int timeout) {
+  __kernel_timespec ts;
+  io_uring_getevents_arg arg;
+  std::memset(&arg, 0, sizeof(arg));
+  if (timeout > 0) {
+    ts.tv_sec = timeout / 1000;
+    ts.tv_nsec = static_cast<long>(timeout % 1000) * 1000000L;
+    arg.ts = reinterpret_cast<uintptr_t>(&ts);
+  }
+
+  unsigned flags = IORING_ENTER_EXT_ARG;
+  if (min_complete > 0) flags |= IORING_ENTER_GETEVENTS;
+
+  int ret = sysEnter(ring_fd_, unsubmitted(), min_complete, flags, &arg,
+                     sizeof(arg));
+  if (ret < 0 && (errno == EINTR || errno == ETIME || errno == EBUSY ||
+                  errno == EAGAIN)) {
+    return 0;
+  }
+  return ret;
+}
+
+/*
+ * @brief Next free SQE; flushes the ring to the kernel if it is full.
+ */
+void* IoUringPoller::getSqe() {
+  unsigned tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) > *sq_mask_) {
+    if (enter(0, 0) < 0) throw std::runtime_error("io_uring_enter failed");
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) > *sq_mask_) {
+      throw std::runtime_error("io_uring: submission queue full");
+    }
+  }
+  io_uring_sqe* sqe =
+      static_cast<io_uring_sqe*>(sqes_) + (tail & *sq_mask_);
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+void IoUringPoller::queuePollAdd(int fd) {
+  FdState& st = fds_[fd];
+  io_uring_sqe* sqe = static_cast<io_uring_sqe*>(getSqe());
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = st.mask;
+  sqe->user_data = makeUserData(fd, st.generation);
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  st.armed = true;
+}
+
+void IoUringPoller::queuePollRemove(int fd) {
+  FdState& st = fds_[fd];
+  io_uring_sqe* sqe = static_cast<io_uring_sqe*>(getSqe());
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = makeUserData(fd, st.generation);
+  sqe->user_data = REMOVE_TAG;
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  st.armed = false;
+}
+
+void IoUringPoller::scheduleRearm(int fd) {
+  FdState& st = fds_[fd];
+  if (st.queued) return;
+  st.queued = true;
+  rearm_.push_back(fd);
+}
+
+IoUringPoller::FdState& IoUringPoller::stateFor(int fd) {
+  if (static_cast<size_t>(fd) >= fds_.size()) fds_.resize(fd + 1);
+  return fds_[fd];
+}
+
+void IoUringPoller::addFd(int fd, uint32_t events) {
+  if (fd < 0) throw std::runtime_error("Failed to add fd to io_uring");
+  FdState& st = stateFor(fd);
+  if (st.armed) queuePollRemove(fd);
+  st.generation = (st.generation + 1) & GENERATION_MASK;
+  st.mask = events & ~UNSUPPORTED_EVENTS;
+  scheduleRearm(fd);
+}
+
+void IoUringPoller::modFd(int fd, uint32_t events) {
+  events &= ~UNSUPPORTED_EVENTS;
+  FdState& st = stateFor(fd);
+  if (st.mask == events) return;
+  if (st.armed) queuePollRemove(fd);
+  st.generation = (st.generation + 1) & GENERATION_MASK;
+  st.mask = events;
+  scheduleRearm(fd);
+}
+
+/*
+ * @brief Forget fd. The POLL_REMOVE is submitted right away: an armed poll
+ * holds a reference on the file, which would keep the socket alive after the
+ * caller close()s it.
+ */
+void IoUringPoller::removeFd(int fd) {
+  if (fd < 0 || static_cast<size_t>(fd) >= fds_.size()) return;
+  FdState& st = fds_[fd];
+  bool was_armed = st.armed;
+  if (was_armed) queuePollRemove(fd);
+  st.generation = (st.generation + 1) & GENERATION_MASK;
+  st.mask = 0;
+  if (was_armed) enter(0, 0);
+}
+
+/*
+ * @brief Arm pending polls, submit and wait, then translate CQEs to
+ * epoll_event. Completions from an older generation (fd removed or mask
+ * changed meanwhile) and POLL_REMOVE results are dropped.
+ */
+int IoUringPoller::wait(epoll_event* events, int maxevents, int timeout) {
+  for (size_t i = 0; i < rearm_.size(); ++i) {
+    int fd = rearm_[i];
+    FdState& st = fds_[fd];
+    st.queued = false;
+    if (st.mask != 0 && !st.armed) queuePollAdd(fd);
+  }
+  rearm_.clear();
+
+  unsigned head = *cq_head_;
+  bool ready = head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  unsigned min_complete = (ready || timeout == 0) ? 0 : 1;
+  if (enter(min_complete, timeout) < 0) {
+    throw std::runtime_error("io_uring_enter failed");
+  }
+
+  int count = 0;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  io_uring_cqe* cqes = static_cast<io_uring_cqe*>(cqes_);
+  while (head != tail && count < maxevents) {
+    const io_uring_cqe& cqe = cqes[head & *cq_mask_];
+    ++head;
+    if (cqe.user_data == REMOVE_TAG) continue;
+
+    int fd = static_cast<int>(cqe.user_data & 0xffffffffu);
+    uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32);
+    if (static_cast<size_t>(fd) >= fds_.size()) continue;
+    FdState& st = fds_[fd];
+    if (st.generation != generation || !st.armed) continue;
+
+    st.armed = false;
+    events[count].data.fd = fd;
+    events[count].events =
+        cqe.res < 0 ? static_cast<uint32_t>(EPOLLERR)
+                    : static_cast<uint32_t>(cqe.res);
+    ++count;
+    if (st.mask != 0) scheduleRearm(fd);
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return count;
+}
+
+bool IoUringPoller::supportsEdgeTriggered() const { return false; }
+
+const char* IoUringPoller::name() const { return "io_uring"; }
+
+#else  // !WEBSERV_HAVE_IO_URING
+
+IoUringPoller::IoUringPoller() {
+  throw std::runtime_error("io_uring: built without <linux/io_uring.h>");
+}
+
+IoUringPoller::~IoUringPoller() {}
+
+void IoUringPoller::release() {}
+
+void IoUringPoller::addFd(int, uint32_t) {}
+void IoUringPoller::modFd(int, uint32_t) {}
+void IoUringPoller::removeFd(int) {}
+int IoUringPoller::wait(epoll_event*, int, int) { return 0; }
+bool IoUringPoller::supportsEdgeTriggered() const { return false; }
+const char* IoUringPoller::name() const { return "io_uring"; }
+
+#endif
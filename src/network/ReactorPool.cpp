@@ -0,0 +1,85 @@
+#include "ReactorPool.hpp"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+ReactorPool::ReactorPool(ConfigStore* store) {
+  ConfigSnapshot* snapshot = store->acquire();
+  int threads = snapshot->getGlobalConfig().getWorkerThreads();
+  snapshot->release();
+  if (threads < 1) {
+    throw std::runtime_error("ReactorPool needs at least one thread");
+  }
+
+  // Bind every reactor up front: a port conflict must abort startup before
+  // any thread is running.
+  try {
+    for (int i = 0; i < threads; ++i) {
+      reactors_.push_back(new ServerManager(store, true));
+    }
+  } catch (...) {
+    destroyReactors();
+    throw;
+  }
+}
+
+ReactorPool::ReactorPool(ConfigSnapshot* snapshot,
+                         const std::vector<TcpListener*>& shared) {
+  int threads = snapshot->getGlobalConfig().getWorkerThreads();
+  if (threads < 1) {
+    throw std::runtime_error("ReactorPool needs at least one thread");
+  }
+
+  try {
+    for (int i = 0; i < threads; ++i) {
+      reactors_.push_back(new ServerManager(snapshot, shared));
+    }
+  } catch (...) {
+    destroyReactors();
+    throw;
+  }
+}
+
+ReactorPool::~ReactorPool() { destroyReactors(); }
+
+void ReactorPool::destroyReactors() {
+  for (size_t i = 0; i < reactors_.size(); ++i) {
+    delete reactors_[i];
+  }
+  reactors_.clear();
+}
+
+void* ReactorPool::threadMain(void* arg) {
+  ServerManager* reactor = static_cast<ServerManager*>(arg);
+  try {
+    reactor->run();
+  } catch (const std::exception& e) {
+    std::cerr << "Reactor thread stopped: " << e.what() << std::endl;
+  }
+  return NULL;
+}
+
+void ReactorPool::run() {
+  std::cout << "Starting " << reactors_.size() << " reactor threads"
+            << std::endl;
+
+  for (size_t i = 0; i < reactors_.size(); ++i) {
+    pthread_t tid;
+    int err = pthread_create(&tid, NULL, &ReactorPool::threadMain,
+                             reactors_[i]);
+    if (err != 0) {
+      std::cerr << "pthread_create failed: " << std::strerror(err)
+                << std::endl;
+      g_running = 0;
+      break;
+    }
+    threads_.push_back(tid);
+  }
+
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    pthread_join(threads_[i], NULL);
+  }
+  threads_.clear();
+}
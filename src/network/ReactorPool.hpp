@@ -0,0 +1,41 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <vector>
+
+#include "ServerManager.hpp"
+#include "config/ConfigStore.hpp"
+
+/**
+ * @brief Runs N independent reactors (worker_threads), one per thread.
+ *
+ * Each reactor is a full ServerManager: its own event backend, its own
+ * listeners (bound with SO_REUSEPORT so the kernel spreads connections
+ * between them) and its own fd table (clients, CGI pipes). A connection lives
+ * and dies in the reactor that accepted it, so the hot path needs no locks.
+ */
+class ReactorPool {
+ public:
+  // Every reactor follows the reloads of `store` on its own listeners.
+  explicit ReactorPool(ConfigStore* store);
+  // Inside a worker_processes worker: every thread shares the inherited
+  // listeners (EPOLLEXCLUSIVE) instead of binding its own.
+  ReactorPool(ConfigSnapshot* snapshot,
+              const std::vector<TcpListener*>& shared);
+  ~ReactorPool();
+
+  // Starts every reactor and blocks until all of them return (g_running).
+  void run();
+
+ private:
+  static void* threadMain(void* arg);
+  void destroyReactors();
+
+  std::vector<ServerManager*> reactors_;
+  std::vector<pthread_t> threads_;
+
+  // Disable copying
+  ReactorPool(const ReactorPool&);
+  ReactorPool& operator=(const ReactorPool&);
+};
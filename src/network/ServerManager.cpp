@@ -1,101 +1,186 @@
 #include "ServerManager.hpp"
 
 #include <sys/epoll.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <cerrno>
 #include <cstdio>
-#include <cstring>
+#include <ctime>
 #include <iostream>
-#include <set>
 #include <stdexcept>
 
-#include "client/Client.hpp"
 #include "client/Client.hpp"
 
-extern bool g_running;
+ServerManager::ServerManager(ConfigStore* store, bool reusePort)
+    : store_(store),
+      snapshot_(store->acquire()),
+      seen_reloads_(g_reload_requests),
+      backend_(EventBackend::create(
+          snapshot_->getGlobalConfig().getEventBackend())),
+      owns_listeners_(true),
+      reuse_port_(reusePort),
+      listener_events_(EPOLLIN),
+      listeners_paused_(false),
+      client_count_(0),
+      configs_(&snapshot_->getServers()),
+      global_(snapshot_->getGlobalConfig()),
+      edge_triggered_(global_.isEdgeTriggered() &&
+                      backend_->supportsEdgeTriggered()),
+      timeouts_(timeoutsFrom(global_)) {
+  if (configs_->empty()) {
+    throw std::runtime_error("No servers provided in config list");
+  }
 
-#define CLIENT_TIMEOUT_SECONDS 60
+  // El servidor no lee ni escribe datos solo acepta conexiones. (EPOLLIN)
+  // Por defecto epoll esta en modo Level Trigger, y para listeners
+  // usualmente es lo correcto/seguro.
+  std::vector<TcpListener*> bound =
+      TcpListener::bindAll(*configs_, listeners_, reuse_port_);
+  for (size_t i = 0; i < bound.size(); ++i) {
+    registerListener(bound[i], EPOLLIN);
+  }
 
-ServerManager::ServerManager(const std::vector<ServerConfig>* configs)
-    : configs_(configs) {
-  std::set<int> bound_ports;
+  if (listeners_.empty()) {
+    throw std::runtime_error(
+        "No servers could be started (check config ports)");
+  }
+}
 
-  if (configs_ == NULL || configs_->empty()) {
+ServerManager::ServerManager(ConfigSnapshot* snapshot,
+                             const std::vector<TcpListener*>& shared)
+    : store_(NULL),
+      snapshot_(snapshot),
+      seen_reloads_(g_reload_requests),
+      backend_(EventBackend::create(
+          snapshot_->getGlobalConfig().getEventBackend())),
+      owns_listeners_(false),
+      reuse_port_(false),
+      listener_events_(EPOLLIN),
+      listeners_paused_(false),
+      client_count_(0),
+      configs_(&snapshot_->getServers()),
+      global_(snapshot_->getGlobalConfig()),
+      edge_triggered_(global_.isEdgeTriggered() &&
+                      backend_->supportsEdgeTriggered()),
+      timeouts_(timeoutsFrom(global_)) {
+  snapshot_->acquire();
+  if (configs_->empty()) {
     throw std::runtime_error("No servers provided in config list");
   }
+  if (shared.empty()) {
+    throw std::runtime_error("No listeners provided to worker");
+  }
 
-  for (size_t i = 0; i < configs_->size(); ++i) {
-    const ServerConfig& server = (*configs_)[i];
-    int port = server.getPort();
+  // EPOLLEXCLUSIVE (Linux >= 4.5): every worker waits on the same listening
+  // socket; without it one connection wakes all of them (thundering herd).
+  // It cannot be combined with EPOLL_CTL_MOD, listeners are never modified.
+  uint32_t events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+  events |= EPOLLEXCLUSIVE;
+#endif
+  for (size_t i = 0; i < shared.size(); ++i) {
+    registerListener(shared[i], events);
+  }
+}
 
-    if (bound_ports.count(port)) {
-      continue;
-    }
-    bound_ports.insert(port);
+ClientTimeouts ServerManager::timeoutsFrom(const GlobalConfig& global) {
+  ClientTimeouts timeouts;
+  timeouts.header = global.getClientHeaderTimeout();
+  timeouts.body = global.getClientBodyTimeout();
+  timeouts.keepalive = global.getKeepaliveTimeout();
+  timeouts.send = global.getSendTimeout();
+  timeouts.bodyMinRate = static_cast<size_t>(global.getClientBodyMinRate());
+  return timeouts;
+}
 
-    TcpListener* listener = new TcpListener(server.getHost(), port);
-    try {
-      listener->listen();
-      int fd = listener->getFd();
+void ServerManager::registerListener(TcpListener* listener, uint32_t events) {
+  int fd = listener->getFd();
 
-      listeners_[fd] = listener;
-      listener_ports_[fd] = port;
+  if (!listeners_paused_) backend_->addFd(fd, events);
+  listeners_.push_back(listener);
+  listener_events_ = events;
 
-      // El servidor no lee ni escribe datos solo acepta conexiones. (EPOLLIN)
-      // Por defecto epoll esta en modo Level Trigger, y para listeners
-      // usualmente es lo correcto/seguro.
-      epoll_.addFd(fd, EPOLLIN);
+  FdEntry& entry = slotFor(fd);
+  entry.kind = FD_LISTENER;
+  entry.listener = listener;
 
-      std::cout << "Server listening on port " << port << std::endl;
-    } catch (const std::exception& e) {
-      delete listener;
-      throw;
-    }
+  std::cout << "Server listening on port " << listener->getPort()
+            << std::endl;
+}
+
+const ServerManager::FdEntry* ServerManager::findFd(int fd) const {
+  if (fd < 0 || static_cast<size_t>(fd) >= fd_table_.size()) return NULL;
+  const FdEntry& entry = fd_table_[fd];
+  return entry.kind == FD_NONE ? NULL : &entry;
+}
+
+ServerManager::FdEntry& ServerManager::slotFor(int fd) {
+  if (static_cast<size_t>(fd) >= fd_table_.size()) {
+    fd_table_.resize(fd + 1);
   }
+  return fd_table_[fd];
+}
 
-  if (listeners_.empty()) {
-    throw std::runtime_error(
-        "No servers could be started (check config ports)");
+void ServerManager::clearFd(int fd) {
+  if (fd >= 0 && static_cast<size_t>(fd) < fd_table_.size()) {
+    fd_table_[fd] = FdEntry();
   }
 }
 
 ServerManager::~ServerManager() {
-  for (std::map<int, Client*>::iterator it = clients_.begin();
-       it != clients_.end(); ++it) {
-    delete it->second;
+  for (size_t fd = 0; fd < fd_table_.size(); ++fd) {
+    if (fd_table_[fd].kind != FD_CLIENT) continue;
+    Client* client = fd_table_[fd].client;
+    clearFd(fd);
+    delete client;  // unregisters its CGI pipes from the table
   }
-  clients_.clear();
 
-  for (std::map<int, TcpListener*>::iterator it = listeners_.begin();
-       it != listeners_.end(); ++it) {
-    delete it->second;
+  if (owns_listeners_) {
+    for (size_t i = 0; i < listeners_.size(); ++i) {
+      delete listeners_[i];
+    }
   }
 
+  delete backend_;
+  snapshot_->release();
   std::cout << "ServerManager shut down" << std::endl;
 }
 
 void ServerManager::run() {
   epoll_event events[MAX_EVENTS];
 
-  std::cout << "Server started. Waiting for events..." << std::endl;
+  std::cout << "Server started (" << backend_->name()
+            << "). Waiting for events..." << std::endl;
 
   while (g_running) {
     try {
-      // INFO: 3s timeout for maintenance tasks
-      int num_events = epoll_.wait(events, MAX_EVENTS, 3000);
+      if (g_reload_requests != seen_reloads_) reloadConfig();
+      if (g_draining && drain()) break;
+
+      // Sleep until the next timer deadline (capped), not a fixed interval
+      int timeout_ms = timers_.nextTimeoutMs(TimerWheel::nowMs(), MAX_WAIT_MS);
+      int num_events = backend_->wait(events, MAX_EVENTS, timeout_ms);
 
       for (int i = 0; i < num_events; ++i) {
         int fd = events[i].data.fd;
         uint32_t event_mask = events[i].events;
 
-        if (listeners_.count(fd)) {
-          handleNewConnection(fd);
-        } else if (clients_.count(fd)) {
-          handleClientEvent(fd, event_mask);
-        } else if (cgi_pipes_.count(fd)) {
-          handleCgiPipeEvent(fd, event_mask);
+        // Single indexed load instead of three map lookups
+        const FdEntry* entry = findFd(fd);
+        if (entry == NULL) continue;  // closed earlier in this batch
+
+        switch (entry->kind) {
+          case FD_LISTENER:
+            handleNewConnection(fd);
+            break;
+          case FD_CLIENT:
+            handleClientEvent(fd, event_mask);
+            break;
+          case FD_CGI_PIPE:
+            handleCgiPipeEvent(fd, event_mask);
+            break;
+          default:
+            break;
         }
       }
 
@@ -106,9 +191,7 @@ void ServerManager::run() {
 #endif  // DEBUG
       }
 
-      // Reap any terminated child CGI processes to prevent zombies
-      // Non-blocking call - returns immediately if no children have exited
-      reapChildren();
+      // CGI children are reaped by their CgiProcess on the pidfd event
       checkTimeouts();
     } catch (const std::exception& e) {
       std::cerr << "Error in event loop: " << e.what() << std::endl;
@@ -116,153 +199,317 @@ void ServerManager::run() {
   }
 }
 
-void ServerManager::reapChildren() {
-  while (true) {
-    int status = 0;
-    pid_t pid = waitpid(-1, &status, WNOHANG);
+// Only the timers that expired are visited: O(expired), not O(clients).
+void ServerManager::checkTimeouts() {
+  long now_ms = TimerWheel::nowMs();
+  std::vector<TimerWheel::Expired> expired;
+  timers_.expire(now_ms, expired);
+
+  for (size_t i = 0; i < expired.size(); ++i) {
+    int fd = expired[i].fd;
+    const FdEntry* entry = findFd(fd);
+    if (entry == NULL || entry->kind != FD_CLIENT) continue;  // already gone
+    Client* client = entry->client;
+
+    if (expired[i].kind == TIMER_CGI) {
+      if (client->checkCgiTimeout()) {
+        updateClientEvents(fd);  // 504 queued, may close the client
+      } else if (client->hasCgi()) {
+        // Not due by the CGI's own clock yet (second granularity)
+        timers_.arm(client->getCgiTimer(), now_ms + 1000);
+      }
+      continue;
+    }
 
-    if (pid > 0) {
-      cgi_exit_statuses_[pid] = status;
-#ifdef DEBUG
-      std::cout << "[CDI] Reaped child PID: " << pid << std::endl;
-#endif  // DEBUG
-    } else if (pid == 0) {
-      break;
-    } else {  // pid == -1
-      if (errno == ECHILD) break;
-      // Real error here
-      std::cerr << "waitpid failed: " << std::strerror(errno) << std::endl;
+    // Activity may have happened since the timer was armed
+    if (client->hasCgi() || !client->checkTimeout(TimerWheel::nowSec())) {
+      armClientTimers(fd, client);
+      continue;
     }
+    std::cout << "Client " << fd << " timed out ("
+              << client->getTimeoutPhase() << ")." << std::endl;
+    handleClientDisconnect(fd);
   }
 }
 
-// Returns true and fills status if the CGI exit code is available.
-// This first checks the cached reaped statuses, then does a non-blocking wait.
-bool ServerManager::consumeCgiExitStatus(pid_t pid, int& status) {
-  std::map<pid_t, int>::iterator it = cgi_exit_statuses_.find(pid);
-  if (it != cgi_exit_statuses_.end()) {
-    status = it->second;
-    cgi_exit_statuses_.erase(it);
-    return true;
-  }
-
-  int wait_status = 0;
-  pid_t ret = waitpid(pid, &wait_status, WNOHANG);
-  if (ret == pid) {
-    status = wait_status;
-    return true;
+// Keeps exactly one timer armed per client: the CGI deadline while a script
+// runs, the idle deadline otherwise. Re-arming is O(1) and skipped when the
+// deadline did not move.
+void ServerManager::armClientTimers(int client_fd, Client* client) {
+  TimerWheel::Node& idle = client->getIdleTimer();
+  TimerWheel::Node& cgi = client->getCgiTimer();
+
+  if (client->hasCgi()) {
+    timers_.cancel(idle);
+    if (!cgi.isArmed()) {
+      cgi.fd = client_fd;
+      cgi.kind = TIMER_CGI;
+      timers_.arm(cgi, static_cast<long>(client->getCgiDeadline()) * 1000);
+    }
+    return;
   }
 
-  return false;
+  timers_.cancel(cgi);
+  // +1s: a client times out once strictly more than its phase timeout
+  // passed (deadlines have second granularity)
+  long deadline_ms =
+      static_cast<long>(client->getTimeoutDeadline()) * 1000 + 1000;
+  if (idle.isArmed() && idle.deadline_ms == deadline_ms) return;
+  idle.fd = client_fd;
+  idle.kind = TIMER_IDLE;
+  timers_.arm(idle, deadline_ms);
 }
 
-void ServerManager::checkTimeouts() {
-  time_t now = time(NULL);
-  std::vector<int> timeout_fds;
+// Accepts at most ACCEPT_BATCH connections, and none beyond
+// max_connections: at the ceiling the listeners leave the poll set, pending
+// connections wait in the kernel backlog instead of being accepted only to
+// starve the clients already being served.
+void ServerManager::handleNewConnection(int listener_fd) {
+  TcpListener* listener = fd_table_[listener_fd].listener;
+  int port = listener->getPort();
+  size_t max_connections = static_cast<size_t>(global_.getMaxConnections());
 
-  // INFO: Iterate over all clients and identify those who timed out
-  double timeout_seconds = CLIENT_TIMEOUT_SECONDS;
+  for (int accepted = 0; accepted < ACCEPT_BATCH; ++accepted) {
+    if (client_count_ >= max_connections) {
+      pauseListeners();
+      return;
+    }
 
-  for (std::map<int, Client*>::iterator it = clients_.begin();
-       it != clients_.end(); ++it) {
-    if (it->second->checkCgiTimeout()) {
-      updateClientEvents(it->first);
-      continue;
+    std::string clientIp;
+    int client_fd = listener->acceptConnection(clientIp);
+    if (client_fd == -1) {
+      if (errno == ECONNABORTED || errno == EINTR) continue;
+      // Out of descriptors: level triggered would report the listener
+      // again right away, wait for a client to close instead
+      if (errno == EMFILE || errno == ENFILE) pauseListeners();
+      return;
     }
 
-    if (difftime(now, it->second->getLastActivity()) > timeout_seconds) {
-      timeout_fds.push_back(it->first);
+    // Level Triggered por defecto; edge_triggered on registra el socket una
+    // sola vez con EPOLLET y la mascara ya no cambia.
+    if (edge_triggered_) {
+      backend_->addFd(client_fd, CLIENT_ET_EVENTS);
+    } else {
+      backend_->addFd(client_fd, EPOLLIN | EPOLLRDHUP);
     }
-  }
 
-  for (size_t i = 0; i < timeout_fds.size(); ++i) {
-    std::cout << "Client " << timeout_fds[i] << " timed out." << std::endl;
-    handleClientDisconnect(timeout_fds[i]);
+    Client* new_client = new Client(client_fd, configs_, port, clientIp);
+    new_client->setServerManager(this);
+    new_client->pinConfig(snapshot_);
+    new_client->setTimeouts(timeouts_);
+    new_client->setEdgeTriggered(edge_triggered_);
+    new_client->setBufferPool(&buffer_pool_);
+    new_client->setBodyBufferSize(
+        static_cast<size_t>(global_.getClientBodyBufferSize()));
+    new_client->setHeaderLimits(
+        static_cast<size_t>(global_.getClientHeaderBufferSize()),
+        static_cast<size_t>(global_.getClientHeaderMaxSize()),
+        static_cast<size_t>(global_.getClientMaxHeaderCount()));
+    new_client->setPipelineDepth(
+        static_cast<size_t>(global_.getPipelineDepth()));
+
+    FdEntry& entry = slotFor(client_fd);
+    entry.kind = FD_CLIENT;
+    entry.client = new_client;
+    armClientTimers(client_fd, new_client);
+    ++client_count_;
+
+#ifdef DEBUG
+    std::cout << "New client connected on port " << port
+              << " (FD: " << client_fd << ")" << std::endl;
+#endif
   }
 }
 
-void ServerManager::handleNewConnection(int listener_fd) {
-  TcpListener* listener = listeners_[listener_fd];
-  int port = listener_ports_[listener_fd];
+/*
+ * @brief Switch to the snapshot of the last SIGHUP.
+ *
+ * Listeners whose host:port is still configured are kept (no connection in
+ * their backlog is lost), new ports are bound, removed ports are closed.
+ * New clients get the new snapshot; clients already connected keep the one
+ * they pinned until they close. If a new port cannot be bound the reactor
+ * stays on its current snapshot.
+ *
+ * Worker processes never reload in place: the master replaces them.
+ */
+void ServerManager::reloadConfig() {
+  seen_reloads_ = g_reload_requests;
+  if (store_ == NULL) return;
+
+  store_->refresh(static_cast<unsigned>(seen_reloads_));
+  ConfigSnapshot* next = store_->acquire();
+  if (next == snapshot_) {
+    next->release();
+    return;
+  }
 
-  while (true) {
-    std::string clientIp;
-    int client_fd = listener->acceptConnection(clientIp);
-    if (client_fd == -1) break;
+  std::vector<TcpListener*> wanted;
+  try {
+    wanted = TcpListener::bindAll(next->getServers(), listeners_, reuse_port_);
+  } catch (const std::exception& e) {
+    std::cerr << "Reload: cannot open listeners (" << e.what()
+              << "), keeping the running configuration" << std::endl;
+    next->release();
+    return;
+  }
+
+  std::vector<TcpListener*> previous;
+  previous.swap(listeners_);
+  for (size_t i = 0; i < previous.size(); ++i) {
+    TcpListener* listener = previous[i];
+    bool kept = false;
+    for (size_t j = 0; j < wanted.size() && !kept; ++j) {
+      kept = (wanted[j] == listener);
+    }
+    if (kept) {
+      listeners_.push_back(listener);
+      continue;
+    }
+    if (!listeners_paused_) backend_->removeFd(listener->getFd());
+    clearFd(listener->getFd());
+    std::cout << "Server stopped listening on port " << listener->getPort()
+              << std::endl;
+    delete listener;
+  }
+  for (size_t i = 0; i < wanted.size(); ++i) {
+    if (findFd(wanted[i]->getFd()) == NULL) {
+      registerListener(wanted[i], listener_events_);
+    }
+  }
 
-    // INFO: Add to Epoll - Level Triggered (no EPOLLET) for safety
-    epoll_.addFd(client_fd, EPOLLIN | EPOLLRDHUP);
+  snapshot_->release();  // freed once no client pins it anymore
+  snapshot_ = next;
+  configs_ = &snapshot_->getServers();
+  global_ = snapshot_->getGlobalConfig();
+  timeouts_ = timeoutsFrom(global_);
+  resumeListeners();  // max_connections may have grown
+}
 
-    Client* new_client = new Client(client_fd, configs_, port, clientIp);
-    new_client->setServerManager(this);
-    clients_[client_fd] = new_client;
+/*
+ * @brief Graceful stop of a retired worker (SIGQUIT from the master after a
+ * reload): stop accepting, close keep-alive connections waiting for their
+ * next request and let the busy ones finish.
+ *
+ * @return true once no client is left
+ */
+bool ServerManager::drain() {
+  pauseListeners();
+  for (size_t fd = 0; fd < fd_table_.size(); ++fd) {
+    if (fd_table_[fd].kind != FD_CLIENT) continue;
+    Client* client = fd_table_[fd].client;
+    if (client->getState() == STATE_IDLE && !client->hasPendingData()) {
+      handleClientDisconnect(static_cast<int>(fd));
+    }
+  }
+  return client_count_ == 0;
+}
 
-    std::cout << "New client connected on port " << listener->getPort()
-              << " (FD: " << client_fd << ")" << std::endl;
+void ServerManager::pauseListeners() {
+  if (listeners_paused_) return;
+  for (size_t i = 0; i < listeners_.size(); ++i) {
+    backend_->removeFd(listeners_[i]->getFd());
+  }
+  listeners_paused_ = true;
+}
+
+void ServerManager::resumeListeners() {
+  if (!listeners_paused_ || g_draining ||
+      client_count_ >= static_cast<size_t>(global_.getMaxConnections())) {
+    return;
+  }
+  for (size_t i = 0; i < listeners_.size(); ++i) {
+    backend_->addFd(listeners_[i]->getFd(), listener_events_);
   }
+  listeners_paused_ = false;
 }
 
 void ServerManager::handleClientEvent(int client_fd, uint32_t events) {
-  Client* client = clients_[client_fd];
+  Client* client = fd_table_[client_fd].client;
 
   if (events & (EPOLLERR | EPOLLHUP)) {
     handleClientDisconnect(client_fd);
     return;
   }
 
-  bool pendingClose = false;
-  if (events & EPOLLRDHUP) {
-    pendingClose = true;
+  // EPOLLRDHUP always comes with EPOLLIN: recv() returning 0 tells the
+  // client the peer half-closed, pending responses are still delivered.
+  if (events & (EPOLLIN | EPOLLRDHUP)) {
+    client->handleRead();
   }
 
-  if (events & EPOLLIN) {
-    client->handleRead();
+  if ((events & EPOLLOUT) && client->getState() != STATE_CLOSED) {
+    client->handleWrite();
+  }
+
+  updateClientEvents(client_fd);
+}
+
+void ServerManager::updateClientEvents(int client_fd) {
+  const FdEntry* entry = findFd(client_fd);
+  if (entry == NULL || entry->kind != FD_CLIENT) return;
+
+  Client* client = entry->client;
+
+  // Responses queued by this event go out right now, in both modes: the
+  // socket is almost always writable, waiting for EPOLLOUT would cost a
+  // loop iteration (and two epoll_ctl in level-triggered mode). EPOLLOUT is
+  // only needed if this send hits EAGAIN.
+  if (client->getState() != STATE_CLOSED) client->tryWrite();
+
+  if (edge_triggered_) {
     if (client->getState() == STATE_CLOSED) {
       handleClientDisconnect(client_fd);
       return;
     }
+    backend_->modFd(client_fd, CLIENT_ET_EVENTS);  // cached: no syscall
+    armClientTimers(client_fd, client);
+    return;
   }
 
-  if (events & EPOLLOUT) {
-    client->handleWrite();
-  }
-
-  if (pendingClose && !client->hasPendingData()) {
+  if (client->getState() == STATE_CLOSED) {
     handleClientDisconnect(client_fd);
     return;
   }
 
-  updateClientEvents(client_fd);
-}
-
-void ServerManager::updateClientEvents(int client_fd) {
-  if (!clients_.count(client_fd)) return;
-
-  Client* client = clients_[client_fd];
-  uint32_t new_events = EPOLLIN | EPOLLRDHUP;
+  // Once the peer half-closed, EPOLLIN/EPOLLRDHUP would fire forever in
+  // level-triggered mode: only wait for writability until the queue drains.
+  // Same while the client's pipeline is full (pipeline_depth): its requests
+  // wait in the socket until the queued responses are out.
+  uint32_t new_events = 0;
+  if (!client->isPeerClosed() && !client->isReadPaused()) {
+    new_events |= EPOLLIN | EPOLLRDHUP;
+  }
   if (client->needsWrite()) {
     new_events |= EPOLLOUT;
   }
-  epoll_.modFd(client_fd, new_events);
+  backend_->modFd(client_fd, new_events);  // skipped if the mask is unchanged
+  armClientTimers(client_fd, client);
 }
 
 void ServerManager::handleClientDisconnect(int client_fd) {
-  epoll_.removeFd(client_fd);
-
-  if (clients_.count(client_fd)) {
-    delete clients_[client_fd];
-    clients_.erase(client_fd);
+  backend_->removeFd(client_fd);
+
+  const FdEntry* entry = findFd(client_fd);
+  if (entry != NULL && entry->kind == FD_CLIENT) {
+    Client* client = entry->client;
+    clearFd(client_fd);
+    delete client;
+    --client_count_;
+    resumeListeners();
   }
 
+#ifdef DEBUG
   std::cout << "Client " << client_fd << " disconnected." << std::endl;
+#endif
 }
 
 void ServerManager::handleCgiPipeEvent(int pipe_fd, uint32_t events) {
-  if (!cgi_pipes_.count(pipe_fd)) {
+  const FdEntry* entry = findFd(pipe_fd);
+  if (entry == NULL || entry->kind != FD_CGI_PIPE) {
     return;
   }
 
-  Client* client = cgi_pipes_[pipe_fd];
+  Client* client = entry->client;
   if (client) {
     client->handleCgiPipe(pipe_fd, events);
     updateClientEvents(client->getFd());
@@ -276,19 +523,23 @@ void ServerManager::registerCgiPipe(int pipe_fd, uint32_t events,
   }
 
   // Add pipe to epoll for monitoring
-  epoll_.addFd(pipe_fd, events);
+  backend_->addFd(pipe_fd, events);
 
   // Track mapping from pipe FD to Client
-  cgi_pipes_[pipe_fd] = client;
+  FdEntry& entry = slotFor(pipe_fd);
+  entry.kind = FD_CGI_PIPE;
+  entry.client = client;
 
   std::cout << "Registered CGI pipe " << pipe_fd << " for events " << events
             << std::endl;
 }
 
 void ServerManager::unregisterCgiPipe(int pipe_fd) {
-  if (cgi_pipes_.count(pipe_fd)) {
-    epoll_.removeFd(pipe_fd);
-    cgi_pipes_.erase(pipe_fd);
+  const FdEntry* entry = findFd(pipe_fd);
+  if (entry != NULL && entry->kind == FD_CGI_PIPE) {
+    backend_->removeFd(pipe_fd);
+    clearFd(pipe_fd);
     std::cout << "Unregistered CGI pipe " << pipe_fd << std::endl;
+    resumeListeners();  // a descriptor was freed (EMFILE pause)
   }
 }
@@ -1,33 +1,72 @@
 #pragma once
 
-#include <map>
+#include <signal.h>
+
 #include <vector>
 
-#include "EpollWrapper.hpp"
+#include "EventBackend.hpp"
 #include "TcpListener.hpp"
 #include "client/Client.hpp"
+#include "common/BufferPool.hpp"
+#include "common/TimerWheel.hpp"
+#include "config/ConfigStore.hpp"
+#include "config/GlobalConfig.hpp"
 #include "config/ServerConfig.hpp"
 
+// Global flag to control every reactor loop (written from signal handlers)
+extern volatile sig_atomic_t g_running;
+// Bumped by SIGHUP: reactors reload the configuration when it changes
+extern volatile sig_atomic_t g_reload_requests;
+// Set in a retired worker process: finish current clients, then exit
+extern volatile sig_atomic_t g_draining;
+
 class ServerManager {
  public:
-  ServerManager(const std::vector<ServerConfig>* configs);
+  // Serves the current snapshot of `store` and follows its reloads.
+  // reusePort: bind listeners with SO_REUSEPORT so several reactors
+  // (worker_threads) can each own a socket on the same port.
+  explicit ServerManager(ConfigStore* store, bool reusePort = false);
+  // Shares listeners already bound by someone else (worker_processes master).
+  // They are not owned and are registered with EPOLLEXCLUSIVE so only one
+  // of the processes blocked on the same socket is woken per connection.
+  // Serves `snapshot` until it exits: the master replaces workers on reload.
+  ServerManager(ConfigSnapshot* snapshot,
+                const std::vector<TcpListener*>& shared);
   ~ServerManager();
 
   void run();
 
-  // CGI pipe registration (called by Client when starting CGI)
+  // Re-syncs the epoll interest of a client after its state changed.
+  // In edge-triggered mode it also flushes pending output. May disconnect
+  // (and delete) the client if it reached STATE_CLOSED.
   void updateClientEvents(int client_fd);
 
+  // CGI pipe registration (called by Client when starting CGI). Also used
+  // for the pidfd of the child, which polls readable when it exits.
+
   void registerCgiPipe(int pipe_fd, uint32_t events, Client* client);
   void unregisterCgiPipe(int pipe_fd);
 
-  // Gets exited child process status
-  bool consumeCgiExitStatus(pid_t pid, int& status);
-
  private:
   // Maximum number of events to process at once
   static const int MAX_EVENTS = 64;
 
+  // Upper bound for epoll_wait() when no timer is due sooner: the loop must
+  // still notice g_running, reloads and draining.
+  static const int MAX_WAIT_MS = 1000;
+
+  // Connections accepted per listener wakeup. The listener stays readable
+  // (level triggered), the rest of the backlog is taken on the next turn
+  // after established clients had their share of the loop.
+  static const int ACCEPT_BATCH = 32;
+
+  // TimerWheel::Node::kind values
+  enum TimerKind { TIMER_IDLE, TIMER_CGI };
+
+  // edge_triggered on: registered once, the mask never changes afterwards
+  static const uint32_t CLIENT_ET_EVENTS =
+      EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+
   // Disable copying
   ServerManager(const ServerManager&);
   ServerManager& operator=(const ServerManager&);
@@ -39,23 +78,61 @@ class ServerManager {
   void handleCgiPipeEvent(int pipe_fd,
                           uint32_t events);  // NEW: Handle CGI output
   void checkTimeouts();
-
-  EpollWrapper epoll_;
-
-  std::map<int, TcpListener*> listeners_;
-
-  const std::vector<ServerConfig>* configs_;
-
-  // Map Listener FD -> Port
-  std::map<int, int> listener_ports_;
-
-  // Active clients
-  std::map<int, Client*> clients_;
-
-  // Map CGI pipe FD -> Client (for CGI output handling)
-  std::map<int, Client*> cgi_pipes_;
-
-  std::map<pid_t, int> cgi_exit_statuses_;
-
-  void reapChildren();
+  void armClientTimers(int client_fd, Client* client);
+  void registerListener(TcpListener* listener, uint32_t events);
+  void pauseListeners();
+  void reloadConfig();
+  static ClientTimeouts timeoutsFrom(const GlobalConfig& global);
+  bool drain();
+  void resumeListeners();
+
+  // Who owns an fd registered in epoll
+  enum FdKind { FD_NONE, FD_LISTENER, FD_CLIENT, FD_CGI_PIPE };
+
+  struct FdEntry {
+    FdKind kind;
+    TcpListener* listener;  // FD_LISTENER
+    Client* client;         // FD_CLIENT, or owner of the FD_CGI_PIPE
+    FdEntry() : kind(FD_NONE), listener(NULL), client(NULL) {}
+  };
+
+  // fd -> owner lookup in O(1). The kernel always hands out the lowest free
+  // descriptor, so the table stays dense and about as long as the number of
+  // open connections.
+  const FdEntry* findFd(int fd) const;
+  FdEntry& slotFor(int fd);
+  void clearFd(int fd);
+
+  // Configuration: the store follows SIGHUP, the snapshot is the one this
+  // reactor serves (pinned by every client accepted under it)
+  ConfigStore* store_;  // NULL in worker processes
+  ConfigSnapshot* snapshot_;
+  sig_atomic_t seen_reloads_;
+
+  // epoll or io_uring (event_backend), owned
+  EventBackend* backend_;
+
+  std::vector<TcpListener*> listeners_;
+  bool owns_listeners_;
+  bool reuse_port_;
+  uint32_t listener_events_;  // EPOLLIN, plus EPOLLEXCLUSIVE when shared
+  // max_connections reached (or out of fds): listeners out of the poll set
+  bool listeners_paused_;
+  size_t client_count_;
+
+  const std::vector<ServerConfig>* configs_;  // snapshot_->getServers()
+  GlobalConfig global_;
+  // edge_triggered on and a backend able to honour EPOLLET
+  bool edge_triggered_;
+  // Per-phase client timeouts of global_
+  ClientTimeouts timeouts_;
+
+  // Listeners, clients and CGI pipes, indexed by fd
+  std::vector<FdEntry> fd_table_;
+
+  // Idle and CGI deadlines of every client
+  TimerWheel timers_;
+
+  // Receive buffers of this reactor's clients (only used on its thread)
+  BufferPool buffer_pool_;
 };
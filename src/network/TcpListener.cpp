@@ -4,6 +4,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <strings.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -13,15 +14,22 @@
 #include <cstdio>
 #include <cstring>
 #include <iostream>
-#include <sstream>
+#include <set>
 #include <stdexcept>
+#include <utility>
 
 #include "common/StringUtils.hpp"
 
-TcpListener::TcpListener(const std::string& host, int port)
-    : socket_fd_(-1), port_(port), host_(host) {
+TcpListener::TcpListener(const std::string& host, int port, bool reusePort,
+                         const ListenOptions& options)
+    : socket_fd_(-1),
+      port_(port),
+      host_(host),
+      reuse_port_(reusePort),
+      options_(options) {
   createSocket();
   setSocketOptions();
+  setTuningOptions();
   bindSocket();
 }
 
@@ -52,10 +60,14 @@ TcpListener::~TcpListener() {
 /// in the kernel file descriptor table. The initial state is blocking;
 /// O_NONBLOCK must be enabled separately via fcntl().
 ///
+/// SOCK_CLOEXEC: a CGI child must not inherit the listener. Otherwise a
+/// reload that drops this port closes our copy only; the script keeps the
+/// socket in LISTEN and the kernel keeps accepting connections nobody serves.
+///
 /// @throws std::runtime_error if socket creation fails
 ///         (EMFILE, ENFILE, ENOMEM, etc.)
 void TcpListener::createSocket() {
-  socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  socket_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
   if (socket_fd_ == -1) {
     throw std::runtime_error("Failed to create socket");
   }
@@ -81,6 +93,12 @@ void TcpListener::createSocket() {
 ///
 ///    Level: SOL_SOCKET (generic, not TCP-specific)
 ///
+/// 1b. SO_REUSEPORT (only when reuse_port_ is set, worker_threads > 1):
+///    Lets every reactor thread bind its own socket to the same host:port.
+///    The kernel hashes incoming connections across the group, so each
+///    reactor accepts only from its own queue (no thundering herd, no
+///    shared accept lock).
+///
 /// 2. O_NONBLOCK (file status flag):
 ///    Enables non-blocking I/O on the socket.
 ///
@@ -111,6 +129,11 @@ void TcpListener::setSocketOptions() {
     close(socket_fd_);
     throw std::runtime_error("Failed to set socket options");
   }
+  if (reuse_port_ &&
+      setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+    close(socket_fd_);
+    throw std::runtime_error("Failed to set SO_REUSEPORT");
+  }
 
   // INFO: El subject prohibe usar otros flags que no sean F_SETFL
   // O_NONBLOCK, FD_CLOEXEC, sin embargo la buena practica para c++ es recuperar
@@ -127,6 +150,80 @@ void TcpListener::setSocketOptions() {
   }
 }
 
+/// Best effort setsockopt: a tuning option the kernel refuses is logged and
+/// the listener keeps working with the default.
+static void tune(int fd, int level, int name, int value, const char* label) {
+  if (setsockopt(fd, level, name, &value, sizeof(value)) < 0) {
+    std::cerr << "Warning: " << label << " not applied: "
+              << std::strerror(errno) << std::endl;
+  }
+}
+
+/// TCP tuning of the listening socket (per `listen` parameters).
+///
+/// Everything set here is inherited by the sockets accept4() returns: the
+/// kernel clones the listener's tcp_sock for each connection, so per
+/// connection setsockopt() calls are not needed.
+///
+/// 1. TCP_NODELAY (always):
+///    Disables Nagle. Responses are written as one buffer per send(), and
+///    Nagle would hold the tail segment of a response until the previous
+///    one is ACKed (40 ms with delayed ACKs). Where several writes should
+///    share packets the writer passes MSG_MORE instead (OutputQueue::flush).
+///
+/// 2. TCP_DEFER_ACCEPT (`deferred`):
+///    The connection is not queued for accept() until the first data
+///    segment arrives, so the reactor is not woken to read an empty socket.
+///
+/// 3. TCP_FASTOPEN (`fastopen=N`):
+///    Clients with a TFO cookie send the request inside the SYN; saves one
+///    RTT before the first byte. N bounds the pending TFO requests.
+///
+/// 4. SO_RCVBUF / SO_SNDBUF (`rcvbuf=`, `sndbuf=`):
+///    Fixed socket buffers (disables autotuning for that direction). Must be
+///    set before listen() for the window scale to take them into account.
+///
+/// 5. TCP_NOTSENT_LOWAT (`notsent_lowat=`):
+///    EPOLLOUT is reported only when less than this many bytes are unsent,
+///    which keeps large responses in user space instead of the send queue.
+///
+/// Failures are warnings: the option is an optimization, not a requirement.
+void TcpListener::setTuningOptions() {
+  tune(socket_fd_, IPPROTO_TCP, TCP_NODELAY, 1, "TCP_NODELAY");
+  if (options_.defer_accept > 0) {
+    tune(socket_fd_, IPPROTO_TCP, TCP_DEFER_ACCEPT, options_.defer_accept,
+         "TCP_DEFER_ACCEPT");
+  }
+  if (options_.fastopen > 0) {
+    tune(socket_fd_, IPPROTO_TCP, TCP_FASTOPEN, options_.fastopen,
+         "TCP_FASTOPEN");
+  }
+  if (options_.rcvbuf > 0) {
+    tune(socket_fd_, SOL_SOCKET, SO_RCVBUF, options_.rcvbuf, "SO_RCVBUF");
+  }
+  if (options_.sndbuf > 0) {
+    tune(socket_fd_, SOL_SOCKET, SO_SNDBUF, options_.sndbuf, "SO_SNDBUF");
+  }
+  if (options_.notsent_lowat > 0) {
+    tune(socket_fd_, IPPROTO_TCP, TCP_NOTSENT_LOWAT, options_.notsent_lowat,
+         "TCP_NOTSENT_LOWAT");
+  }
+}
+
+/// Options removed from the config go back to the kernel defaults, except
+/// fastopen and the buffer sizes, which keep their last value until restart.
+void TcpListener::applyOptions(const ListenOptions& options) {
+  if (options == options_) return;
+  if (options.defer_accept == 0 && options_.defer_accept > 0) {
+    tune(socket_fd_, IPPROTO_TCP, TCP_DEFER_ACCEPT, 0, "TCP_DEFER_ACCEPT");
+  }
+  if (options.notsent_lowat == 0 && options_.notsent_lowat > 0) {
+    tune(socket_fd_, IPPROTO_TCP, TCP_NOTSENT_LOWAT, 0, "TCP_NOTSENT_LOWAT");
+  }
+  options_ = options;
+  setTuningOptions();
+}
+
 /// Binds the socket to a specific port on all network interfaces.
 ///
 /// Associates the socket with a local address (IP + port) so the kernel
@@ -295,6 +392,23 @@ void TcpListener::listen() {
   std::cout << "Listening for connections..." << std::endl;
 }
 
+/// Manual dotted-quad formatting to replace inet_ntop (forbidden).
+/// Writes into a fixed buffer: no stream, no allocation beyond the string.
+static void formatIpv4(const struct in_addr& addr, std::string& out) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&addr);
+  char buf[16];  // "255.255.255.255"
+  size_t len = 0;
+
+  for (int i = 0; i < 4; ++i) {
+    unsigned int b = bytes[i];
+    if (b >= 100) buf[len++] = static_cast<char>('0' + b / 100);
+    if (b >= 10) buf[len++] = static_cast<char>('0' + (b / 10) % 10);
+    buf[len++] = static_cast<char>('0' + b % 10);
+    if (i < 3) buf[len++] = '.';
+  }
+  out.assign(buf, len);
+}
+
 /// Accepts a pending client connection from the accept queue.
 ///
 /// Extracts the first completed connection from the kernel's accept queue
@@ -334,31 +448,26 @@ void TcpListener::listen() {
 /// Why O_NONBLOCK on the new socket is CRITICAL:
 ///
 /// - accept() does NOT inherit flags from the listening socket
-/// - New client_fd starts in blocking mode (kernel default)
-/// - Without fcntl(O_NONBLOCK): read/write on client_fd would block
-/// - Consequence: one slow client stalls the entire server
-///
-/// Implementation: fcntl() read–modify–write pattern
-/// - F_GETFL: read current flags (preserves O_LARGEFILE, etc.)
-/// - OR with O_NONBLOCK: atomically add flag
-/// - F_SETFL: write modified flags back
+/// - A blocking client_fd would let one slow client stall the whole server
 ///
-/// Alternative (Linux ≥ 2.6.28):
-/// - accept4(fd, addr, len, SOCK_NONBLOCK | SOCK_CLOEXEC)
-/// - Reason not used: portability; POSIX compliance
+/// Implementation: accept4(fd, addr, len, SOCK_NONBLOCK | SOCK_CLOEXEC)
+/// - The socket is created non-blocking: no fcntl() F_GETFL/F_SETFL pair
+///   per connection (two syscalls saved on every accept)
+/// - SOCK_CLOEXEC: CGI children forked later do not inherit client sockets
 ///
 /// sockaddr_in extraction:
 ///
 /// 1. sin_addr.s_addr:
 ///    Client IP address in network byte order (big-endian).
 ///    - Example: 192.168.1.100 → 0xC0A80164 in memory
-///    - inet_ntop() converts to human-readable "192.168.1.100"
+///    - formatIpv4() converts to human-readable "192.168.1.100"
 ///
 /// 2. sin_port:
 ///    Client ephemeral port in network byte order.
 ///    - Range: 32768–60999 (Linux default
 ///    /proc/sys/net/ipv4/ip_local_port_range)
-///    - ntohs() converts to host order for logging
+///    - Not used: connections are not logged one by one (a connection
+///      storm would spend its time in std::cout)
 ///
 /// 3. addr_len (value-result parameter):
 ///    - Input: size of client_addr buffer
@@ -367,14 +476,8 @@ void TcpListener::listen() {
 ///
 /// Security considerations:
 ///
-/// - bzero() before use: ensures uninitialized memory doesn't leak
-/// - inet_ntop() with INET_ADDRSTRLEN: buffer overflow protection
-/// - Failed fcntl() doesn't abort: graceful degradation
-///
-/// Why client IP/port logging is useful:
-/// - Debugging: correlate requests with specific clients
-/// - Security: identify attack sources (rate limiting, ban lists)
-/// - Analytics: geographic distribution, connection patterns
+/// - formatIpv4() writes into a fixed 16 byte buffer ("255.255.255.255")
+/// - The client IP is kept for CGI (REMOTE_ADDR)
 ///
 /// Error conditions and handling:
 ///
@@ -382,13 +485,10 @@ void TcpListener::listen() {
 ///   → EAGAIN/EWOULDBLOCK: no connections available (non-blocking)
 ///   → EMFILE/ENFILE: process/system file descriptor limit reached
 ///   → ENOMEM: kernel out of memory
+///   → ECONNABORTED: peer reset while queued (ignored, try the next one)
 ///   → EINTR: interrupted by signal (handled by retry)
-///   → Function returns -1; caller must check and handle
-///
-/// - fcntl() failure:
-///   → Client socket remains blocking (degraded, but functional)
-///   → Server can still communicate; performance impact only
-///   → Silent failure (no exception); logged implicitly
+///   → Function returns -1 with errno preserved; the caller pauses the
+///     listener on EMFILE/ENFILE instead of spinning on it
 ///
 /// Resource management:
 ///
@@ -401,39 +501,75 @@ void TcpListener::listen() {
 /// - New socket: fd = client_fd, state = ESTABLISHED, peer = client_addr
 /// - TCP connection: fully established, ready for send/recv
 ///
+/// @return client_fd on success,
 ///         -1 on failure (check errno: EAGAIN, EMFILE, ENOMEM, etc.)
 int TcpListener::acceptConnection(std::string& clientIp) {
   struct sockaddr_in client_addr;
   socklen_t addr_len = sizeof(client_addr);
 
-  std::memset(&client_addr, 0, size_t(addr_len));
-  int client_fd = accept(socket_fd_, (struct sockaddr*)&client_addr, &addr_len);
+  int client_fd = accept4(socket_fd_, (struct sockaddr*)&client_addr,
+                          &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
 
   if (client_fd < 0) {
-    if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      std::cerr << "accept failed: " << std::strerror(errno) << std::endl;
+    int saved = errno;
+    if (saved != EAGAIN && saved != EWOULDBLOCK && saved != ECONNABORTED &&
+        saved != EINTR) {
+      std::cerr << "accept failed: " << std::strerror(saved) << std::endl;
     }
+    errno = saved;
     return -1;
   }
 
-  int flags = fcntl(client_fd, F_GETFL, 0);
-  if (flags != -1) {
-    fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
-  }
-
-  // Manual IP formatting to replace inet_ntop (forbidden)
-  unsigned char* ip_bytes = (unsigned char*)&client_addr.sin_addr;
-  std::ostringstream oss;
-  oss << (int)ip_bytes[0] << "." << (int)ip_bytes[1] << "." << (int)ip_bytes[2]
-      << "." << (int)ip_bytes[3];
-  clientIp = oss.str();
-  std::cout << "New connection from " << clientIp << ":"
-            << ntohs(client_addr.sin_port) << " (fd: " << client_fd << ")"
-            << std::endl;
-
+  formatIpv4(client_addr.sin_addr, clientIp);
   return client_fd;
 }
 
 int TcpListener::getFd() const { return socket_fd_; }
 
+const std::string& TcpListener::getHost() const { return host_; }
+
+std::vector<TcpListener*> TcpListener::bindAll(
+    const std::vector<ServerConfig>& configs,
+    const std::vector<TcpListener*>& current, bool reusePort) {
+  std::vector<TcpListener*> result;
+  std::vector<TcpListener*> created;
+  // Reused listeners keep their options until every bind succeeded: a
+  // failed reload must leave the running ones untouched
+  std::vector<std::pair<TcpListener*, ListenOptions> > kept;
+  std::set<int> bound_ports;
+
+  try {
+    for (size_t i = 0; i < configs.size(); ++i) {
+      const ServerConfig& server = configs[i];
+      int port = server.getPort();
+      if (bound_ports.count(port)) continue;
+      bound_ports.insert(port);
+
+      TcpListener* listener = NULL;
+      for (size_t j = 0; j < current.size() && listener == NULL; ++j) {
+        if (current[j]->getPort() == port &&
+            current[j]->getHost() == server.getHost()) {
+          listener = current[j];
+        }
+      }
+      if (listener == NULL) {
+        listener = new TcpListener(server.getHost(), port, reusePort,
+                                   server.getListenOptions());
+        created.push_back(listener);
+        listener->listen();
+      } else {
+        kept.push_back(std::make_pair(listener, server.getListenOptions()));
+      }
+      result.push_back(listener);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < created.size(); ++i) delete created[i];
+    throw;
+  }
+  for (size_t i = 0; i < kept.size(); ++i) {
+    kept[i].first->applyOptions(kept[i].second);
+  }
+  return result;
+}
+
 int TcpListener::getPort() const { return port_; }
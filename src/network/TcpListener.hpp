@@ -1,10 +1,14 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include "config/ServerConfig.hpp"
 
 class TcpListener {
  public:
-  TcpListener(const std::string& host, int port);
+  TcpListener(const std::string& host, int port, bool reusePort = false,
+              const ListenOptions& options = ListenOptions());
   ~TcpListener();
 
   void listen();
@@ -15,13 +19,31 @@ class TcpListener {
 
   int getPort() const;
 
+  const std::string& getHost() const;
+
+  // Re-applies the `listen` socket parameters (reload of a kept listener)
+  void applyOptions(const ListenOptions& options);
+
+  // One listener per port of `configs` (first server of a port wins).
+  // Listeners of `current` with the same host:port are reused, the others
+  // are bound now; on failure the ones bound here are closed and the
+  // exception propagates. Reused listeners only get their new options once
+  // every bind succeeded. Entries of `current` left out of the result are
+  // for the caller to close.
+  static std::vector<TcpListener*> bindAll(
+      const std::vector<ServerConfig>& configs,
+      const std::vector<TcpListener*>& current, bool reusePort);
+
  private:
   int socket_fd_;
   int port_;
   std::string host_;
+  bool reuse_port_;
+  ListenOptions options_;
 
   void createSocket();
   void setSocketOptions();
+  void setTuningOptions();
   void bindSocket();
 
   // Disable copying
@@ -0,0 +1,222 @@
+#include "WorkerSupervisor.hpp"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+#include "ReactorPool.hpp"
+#include "ServerManager.hpp"
+
+WorkerSupervisor::WorkerSupervisor(ConfigStore* store)
+    : store_(store),
+      snapshot_(store->acquire()),
+      seen_reloads_(g_reload_requests),
+      workers_(snapshot_->getGlobalConfig().getWorkerProcesses(), -1),
+      spawned_at_(workers_.size(), 0) {
+  if (snapshot_->getServers().empty()) {
+    snapshot_->release();
+    throw std::runtime_error("No servers provided in config list");
+  }
+  try {
+    bindListeners(snapshot_->getServers());
+  } catch (...) {
+    snapshot_->release();
+    throw;
+  }
+}
+
+WorkerSupervisor::~WorkerSupervisor() {
+  for (size_t i = 0; i < listeners_.size(); ++i) {
+    delete listeners_[i];
+  }
+  snapshot_->release();
+}
+
+// Same dedup rule as ServerManager: one listening socket per port. Sockets
+// of ports still configured are kept, the others are closed here (retired
+// workers hold their own copy until they exit).
+void WorkerSupervisor::bindListeners(const std::vector<ServerConfig>& configs) {
+  std::vector<TcpListener*> wanted =
+      TcpListener::bindAll(configs, listeners_, false);
+
+  for (size_t i = 0; i < listeners_.size(); ++i) {
+    bool kept = false;
+    for (size_t j = 0; j < wanted.size() && !kept; ++j) {
+      kept = (wanted[j] == listeners_[i]);
+    }
+    if (!kept) delete listeners_[i];
+  }
+  listeners_.swap(wanted);
+}
+
+void WorkerSupervisor::run() {
+  std::cout << "Master " << getpid() << " starting " << workers_.size()
+            << " worker processes" << std::endl;
+
+  for (size_t slot = 0; slot < workers_.size(); ++slot) {
+    spawnWorker(slot);
+  }
+
+  while (g_running) {
+    if (g_reload_requests != seen_reloads_) reload();
+
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, WNOHANG);
+
+    if (pid > 0) {
+      handleWorkerExit(pid, status);
+      continue;
+    }
+    if (pid == -1 && errno != ECHILD && errno != EINTR) {
+      std::cerr << "waitpid failed: " << std::strerror(errno) << std::endl;
+    }
+    // sleep() is interrupted by SIGINT/SIGTERM, shutdown is not delayed
+    sleep(1);
+  }
+
+  stopWorkers();
+}
+
+void WorkerSupervisor::reload() {
+  seen_reloads_ = g_reload_requests;
+  store_->refresh(static_cast<unsigned>(seen_reloads_));
+  ConfigSnapshot* next = store_->acquire();
+  if (next == snapshot_) {
+    next->release();
+    return;
+  }
+
+  try {
+    bindListeners(next->getServers());
+  } catch (const std::exception& e) {
+    std::cerr << "Reload: cannot open listeners (" << e.what()
+              << "), keeping the running workers" << std::endl;
+    next->release();
+    return;
+  }
+  snapshot_->release();
+  snapshot_ = next;
+
+  // New generation first: the listeners never stop being served
+  for (size_t slot = 0; slot < workers_.size(); ++slot) {
+    pid_t old = workers_[slot];
+    spawnWorker(slot);
+    if (old > 0) {
+      kill(old, SIGQUIT);
+      retiring_.push_back(old);
+    }
+  }
+}
+
+// Child side of SIGQUIT: drain instead of stopping right away
+static void handleDrainSignal(int sig) {
+  (void)sig;
+  g_draining = 1;
+}
+
+void WorkerSupervisor::spawnWorker(size_t slot) {
+  // Flush before fork so buffered output is not printed twice
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid = fork();
+  if (pid == -1) {
+    std::cerr << "Failed to fork worker: " << std::strerror(errno)
+              << std::endl;
+    workers_[slot] = -1;
+    return;
+  }
+  if (pid == 0) {
+    runWorker();  // never returns
+  }
+
+  workers_[slot] = pid;
+  spawned_at_[slot] = time(NULL);
+  std::cout << "Worker " << slot << " started (pid " << pid << ")"
+            << std::endl;
+}
+
+// Child side: serve on the inherited listeners until g_running drops.
+// exit() instead of return so the child never unwinds into the master's
+// stack (main() would run the master's destructors a second time).
+void WorkerSupervisor::runWorker() {
+  // Reloads are the master's job; SIGQUIT from the master means "retire"
+  signal(SIGHUP, SIG_IGN);
+  signal(SIGQUIT, handleDrainSignal);
+
+  int code = 0;
+  try {
+    if (snapshot_->getGlobalConfig().getWorkerThreads() > 1) {
+      ReactorPool pool(snapshot_, listeners_);
+      pool.run();
+    } else {
+      ServerManager server(snapshot_, listeners_);
+      server.run();
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Worker " << getpid() << " failed: " << e.what()
+              << std::endl;
+    code = 1;
+  }
+  std::cout.flush();
+  std::exit(code);
+}
+
+void WorkerSupervisor::handleWorkerExit(pid_t pid, int status) {
+  for (size_t i = 0; i < retiring_.size(); ++i) {
+    if (retiring_[i] == pid) {
+      retiring_.erase(retiring_.begin() + i);
+      std::cout << "Retired worker (pid " << pid << ") drained" << std::endl;
+      return;
+    }
+  }
+
+  size_t slot = 0;
+  while (slot < workers_.size() && workers_[slot] != pid) ++slot;
+  if (slot == workers_.size()) return;  // not one of ours
+
+  workers_[slot] = -1;
+  if (WIFSIGNALED(status)) {
+    std::cerr << "Worker " << slot << " (pid " << pid << ") killed by signal "
+              << WTERMSIG(status) << std::endl;
+  } else {
+    std::cerr << "Worker " << slot << " (pid " << pid << ") exited with code "
+              << WEXITSTATUS(status) << std::endl;
+  }
+
+  if (!g_running) return;
+
+  // Crash loop guard: do not fork-bomb if the worker dies right away
+  if (difftime(time(NULL), spawned_at_[slot]) < RESPAWN_BACKOFF_SECONDS) {
+    sleep(RESPAWN_BACKOFF_SECONDS);
+    if (!g_running) return;
+  }
+  spawnWorker(slot);
+}
+
+void WorkerSupervisor::stopWorkers() {
+  // Draining workers are stopped (and waited for) like the current ones
+  workers_.insert(workers_.end(), retiring_.begin(), retiring_.end());
+  retiring_.clear();
+  for (size_t slot = 0; slot < workers_.size(); ++slot) {
+    if (workers_[slot] > 0) {
+      kill(workers_[slot], SIGTERM);
+    }
+  }
+  for (size_t slot = 0; slot < workers_.size(); ++slot) {
+    if (workers_[slot] <= 0) continue;
+    int status = 0;
+    while (waitpid(workers_[slot], &status, 0) == -1 && errno == EINTR) {
+    }
+    workers_[slot] = -1;
+  }
+  std::cout << "Master " << getpid() << ": all workers stopped" << std::endl;
+}
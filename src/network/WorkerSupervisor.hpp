@@ -0,0 +1,61 @@
+#pragma once
+
+#include <signal.h>
+#include <sys/types.h>
+
+#include <ctime>
+#include <vector>
+
+#include "TcpListener.hpp"
+#include "config/ConfigStore.hpp"
+
+/**
+ * @brief Pre-fork master for worker_processes > 1.
+ *
+ * The master binds every listener once, forks N workers that inherit them
+ * and then only supervises: a worker that dies (e.g. a crash triggered by a
+ * CGI) is respawned in its slot while the others keep serving. Workers run
+ * a normal ServerManager (or a ReactorPool when worker_threads > 1) on the
+ * shared listeners, registered with EPOLLEXCLUSIVE.
+ *
+ * SIGHUP: the master reloads the store, binds the new ports (unchanged ones
+ * keep their socket and backlog), forks a new generation of workers on the
+ * new snapshot and sends SIGQUIT to the old ones, which stop accepting and
+ * exit once their current connections are done.
+ */
+class WorkerSupervisor {
+ public:
+  explicit WorkerSupervisor(ConfigStore* store);
+  ~WorkerSupervisor();
+
+  // Master loop: returns after g_running drops and every worker exited.
+  void run();
+
+ private:
+  // A worker that dies sooner than this after its fork is considered to be
+  // crash-looping and its respawn is delayed by the same amount.
+  static const int RESPAWN_BACKOFF_SECONDS = 1;
+
+  void bindListeners(const std::vector<ServerConfig>& configs);
+  void reload();
+  void spawnWorker(size_t slot);
+  void runWorker();
+  void handleWorkerExit(pid_t pid, int status);
+  void stopWorkers();
+
+  ConfigStore* store_;
+  ConfigSnapshot* snapshot_;  // what newly forked workers serve
+  sig_atomic_t seen_reloads_;
+
+  std::vector<TcpListener*> listeners_;
+
+  // One slot per worker: pid (-1 when not running) and fork time
+  std::vector<pid_t> workers_;
+  std::vector<time_t> spawned_at_;
+  // Previous generations still draining after a reload
+  std::vector<pid_t> retiring_;
+
+  // Disable copying
+  WorkerSupervisor(const WorkerSupervisor&);
+  WorkerSupervisor& operator=(const WorkerSupervisor&);
+};
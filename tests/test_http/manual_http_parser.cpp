@@ -108,6 +108,42 @@ int main()
         assertTrue(parser.getState() == ERROR, "Header sin ':' -> ERROR");
     }
 
+    // Caso 6: Límites de cabecera (sin esperar al final de la línea)
+    {
+        HttpParser parser;
+        parser.setHeaderLimits(32, 64, 2);
+        parser.consume("GET /" + std::string(40, 'a'));
+        assertTrue(parser.getState() == ERROR && parser.getErrorStatusCode() == 414,
+                   "Start line larga sin \\r\\n -> 414");
+    }
+    {
+        HttpParser parser;
+        parser.setHeaderLimits(32, 64, 2);
+        parser.consume("GET / HTTP/1.1\r\nX-Big: " + std::string(30, 'b'));
+        assertTrue(parser.getState() == ERROR && parser.getErrorStatusCode() == 431,
+                   "Header largo -> 431");
+    }
+    {
+        HttpParser parser;
+        parser.setHeaderLimits(32, 64, 2);
+        parser.consume("GET / HTTP/1.1\r\nHost: a\r\nA: 1\r\nB: 2\r\n\r\n");
+        assertTrue(parser.getState() == ERROR && parser.getErrorStatusCode() == 431,
+                   "Demasiados headers -> 431");
+    }
+    {
+        HttpParser parser;
+        parser.setHeaderLimits(32, 64, 10);
+        parser.consume("GET / HTTP/1.1\r\nHost: a\r\nA: 11111111111111111111\r\nB: 22222222222222222222\r\n");
+        assertTrue(parser.getState() == ERROR && parser.getErrorStatusCode() == 431,
+                   "Cabecera total > límite -> 431");
+    }
+    {
+        HttpParser parser;
+        parser.setHeaderLimits(32, 64, 2);
+        parser.consume("GET / HTTP/1.1\r\nHost: a\r\nA: 1\r\n\r\n");
+        assertTrue(parser.getState() == COMPLETE, "Dentro de los límites -> COMPLETE");
+    }
+
     if (g_failures == 0)
         std::cout << "\nTodos los tests pasaron." << std::endl;
     else
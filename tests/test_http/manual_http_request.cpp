@@ -45,9 +45,9 @@ int main()
     chunk.push_back('\0');
     chunk.push_back('B');
     req.addBody(chunk.begin(), chunk.end());
-    std::vector<char> body = req.getBody();
+    const RequestBody& body = req.getBody();
     assertTrue(body.size() == 3, "Body size (incluye null)");
-    assertTrue(body[0] == 'A' && body[1] == '\0' && body[2] == 'B', "Body content");
+    assertTrue(body.data()[0] == 'A' && body.data()[1] == '\0' && body.data()[2] == 'B', "Body content");
 
     // Test 5: shouldCloseConnection()
     req.setVersion("HTTP/1.1");
@@ -0,0 +1,213 @@
+#include <vector>
+
+#include "../../lib/catch2/catch.hpp"
+#include "../../src/common/TimerWheel.hpp"
+
+// ============================================================================
+// TimerWheel: the wheel starts at TimerWheel::nowMs(), every test drives
+// expire() with explicit times from that base (aligned to a tick)
+// ============================================================================
+
+namespace {
+
+const long TICK = TimerWheel::TICK_MS;
+const long REVOLUTION = TimerWheel::TICK_MS * TimerWheel::SLOTS;
+
+// Advances one tick at a time, like the event loop does, until `until`.
+// Returns the time at which fd expired, or -1.
+long stepUntil(TimerWheel& wheel, long from, long until, int fd) {
+  for (long now = from; now <= until; now += TICK) {
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(now, expired);
+    for (size_t i = 0; i < expired.size(); ++i) {
+      if (expired[i].fd == fd) return now;
+    }
+  }
+  return -1;
+}
+
+long tickBase() { return TimerWheel::nowMs() / TICK * TICK; }
+
+}  // namespace
+
+TEST_CASE("TimerWheel: schedule and expire", "[common][timer]") {
+  TimerWheel wheel;
+  long base = tickBase();
+
+  SECTION("Never fires before its deadline") {
+    TimerWheel::Node node;
+    node.fd = 7;
+    node.kind = 1;
+    wheel.arm(node, base + 250);
+    REQUIRE(node.isArmed());
+
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base + 100, expired);
+    REQUIRE(expired.empty());
+
+    long fired = stepUntil(wheel, base + 200, base + 1000, 7);
+    REQUIRE(fired >= base + 250);
+    REQUIRE(fired < base + 250 + TICK);
+    REQUIRE_FALSE(node.isArmed());
+  }
+
+  SECTION("Expired entries carry fd and kind") {
+    TimerWheel::Node a;
+    TimerWheel::Node b;
+    a.fd = 3;
+    a.kind = 1;
+    b.fd = 4;
+    b.kind = 2;
+    wheel.arm(a, base + 10);
+    wheel.arm(b, base + 20);
+
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base + 500, expired);
+    REQUIRE(expired.size() == 2);
+    REQUIRE(expired[0].fd + expired[1].fd == 7);
+    REQUIRE(expired[0].kind + expired[1].kind == 3);
+  }
+
+  SECTION("A deadline already in the past fires on the next expire") {
+    TimerWheel::Node node;
+    node.fd = 5;
+    wheel.arm(node, base - 5000);
+
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base, expired);
+    REQUIRE(expired.size() == 1);
+    REQUIRE(expired[0].fd == 5);
+  }
+
+  SECTION("Re-arming moves the deadline") {
+    TimerWheel::Node node;
+    node.fd = 9;
+    wheel.arm(node, base + 200);
+    wheel.arm(node, base + 2000);
+
+    REQUIRE(stepUntil(wheel, base, base + 1500, 9) == -1);
+    REQUIRE(stepUntil(wheel, base + 1600, base + 3000, 9) >= base + 2000);
+  }
+}
+
+TEST_CASE("TimerWheel: cancel", "[common][timer]") {
+  TimerWheel wheel;
+  long base = tickBase();
+
+  SECTION("A cancelled timer never fires") {
+    TimerWheel::Node node;
+    node.fd = 11;
+    wheel.arm(node, base + 300);
+    wheel.cancel(node);
+    REQUIRE_FALSE(node.isArmed());
+    REQUIRE(stepUntil(wheel, base, base + 2000, 11) == -1);
+  }
+
+  SECTION("Cancelling one node leaves the rest of its slot armed") {
+    TimerWheel::Node a;
+    TimerWheel::Node b;
+    TimerWheel::Node c;
+    a.fd = 1;
+    b.fd = 2;
+    c.fd = 3;
+    wheel.arm(a, base + 300);
+    wheel.arm(b, base + 300);
+    wheel.arm(c, base + 300);
+    wheel.cancel(b);
+
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base + 400, expired);
+    REQUIRE(expired.size() == 2);
+    REQUIRE(expired[0].fd != 2);
+    REQUIRE(expired[1].fd != 2);
+  }
+
+  SECTION("Destroying an armed node unlinks it") {
+    {
+      TimerWheel::Node node;
+      node.fd = 12;
+      wheel.arm(node, base + 300);
+    }
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base + 400, expired);
+    REQUIRE(expired.empty());
+  }
+}
+
+TEST_CASE("TimerWheel: deadlines across slot wrap", "[common][timer]") {
+  TimerWheel wheel;
+  long base = tickBase();
+
+  SECTION("More than one revolution ahead waits for its own tick") {
+    // Same slot as base + 500, one revolution later
+    TimerWheel::Node node;
+    node.fd = 21;
+    wheel.arm(node, base + REVOLUTION + 500);
+
+    REQUIRE(stepUntil(wheel, base, base + REVOLUTION, 21) == -1);
+    REQUIRE(node.isArmed());
+    long fired = stepUntil(wheel, base + REVOLUTION + TICK,
+                           base + REVOLUTION + 2000, 21);
+    REQUIRE(fired >= base + REVOLUTION + 500);
+    REQUIRE(fired < base + REVOLUTION + 500 + TICK);
+  }
+
+  SECTION("Slots are reused after the cursor wraps") {
+    REQUIRE(stepUntil(wheel, base, base + REVOLUTION - TICK, -1) == -1);
+
+    TimerWheel::Node node;
+    node.fd = 22;
+    long now = base + REVOLUTION;
+    wheel.arm(node, now + 300);
+    long fired = stepUntil(wheel, now, now + 1000, 22);
+    REQUIRE(fired >= now + 300);
+    REQUIRE(fired < now + 300 + TICK);
+  }
+
+  SECTION("A stall longer than a revolution expires everything due") {
+    TimerWheel::Node a;
+    TimerWheel::Node b;
+    a.fd = 31;
+    b.fd = 32;
+    wheel.arm(a, base + 1000);
+    wheel.arm(b, base + 3 * REVOLUTION);
+
+    std::vector<TimerWheel::Expired> expired;
+    wheel.expire(base + 5 * REVOLUTION, expired);
+    REQUIRE(expired.size() == 2);
+  }
+}
+
+TEST_CASE("TimerWheel: nextTimeoutMs", "[common][timer]") {
+  TimerWheel wheel;
+  long base = tickBase();
+
+  SECTION("Empty wheel waits the maximum") {
+    REQUIRE(wheel.nextTimeoutMs(base, 1000) == 1000);
+  }
+
+  SECTION("Wakes up by the first armed slot") {
+    TimerWheel::Node node;
+    node.fd = 41;
+    wheel.arm(node, base + 450);
+    int wait = wheel.nextTimeoutMs(base, 5000);
+    REQUIRE(wait <= 500);
+    REQUIRE(wait >= 450 - TICK);
+  }
+
+  SECTION("Beyond max_ms the cap wins") {
+    TimerWheel::Node node;
+    node.fd = 42;
+    wheel.arm(node, base + 10000);
+    REQUIRE(wheel.nextTimeoutMs(base, 1000) == 1000);
+  }
+}
+
+TEST_CASE("TimerWheel: monotonic clock", "[common][timer]") {
+  long a = TimerWheel::nowMs();
+  long b = TimerWheel::nowMs();
+  REQUIRE(b >= a);
+  time_t sec = TimerWheel::nowSec();
+  REQUIRE(sec >= static_cast<time_t>(b / 1000));
+  REQUIRE(sec <= static_cast<time_t>(b / 1000) + 1);
+}
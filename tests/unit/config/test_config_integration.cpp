@@ -79,6 +79,67 @@ TEST_CASE("Integration: Invalid IP formats in listen directive",
   }
 }
 
+TEST_CASE("Integration: Socket parameters in listen directive",
+          "[config][integration][listen]") {
+  SECTION("All parameters") {
+    std::ofstream file("test_listen_options.conf");
+    file << "server {\n"
+         << "    listen 127.0.0.1:8080 deferred=5s fastopen=128 rcvbuf=64k "
+            "sndbuf=1m notsent_lowat=16k;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_listen_options.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    const ListenOptions& options =
+        parser.getServers()[0].getListenOptions();
+    REQUIRE(parser.getServers()[0].getPort() == 8080);
+    REQUIRE(options.defer_accept == 5);
+    REQUIRE(options.fastopen == 128);
+    REQUIRE(options.rcvbuf == 64 * 1024);
+    REQUIRE(options.sndbuf == 1024 * 1024);
+    REQUIRE(options.notsent_lowat == 16 * 1024);
+    std::remove("test_listen_options.conf");
+  }
+
+  SECTION("Bare deferred uses the default and the rest stays off") {
+    std::ofstream file("test_listen_deferred.conf");
+    file << "server {\n"
+         << "    listen 8080 deferred;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_listen_deferred.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    const ListenOptions& options =
+        parser.getServers()[0].getListenOptions();
+    REQUIRE(options.defer_accept == config::section::default_defer_accept);
+    REQUIRE(options.fastopen == 0);
+    REQUIRE(options.rcvbuf == 0);
+    std::remove("test_listen_deferred.conf");
+  }
+
+  SECTION("Unknown or empty parameters are rejected") {
+    const char* bad[] = {"backlog=10", "fastopen", "fastopen=0", "rcvbuf=",
+                         "sndbuf=-1", "rcvbuf=4g", "notsent_lowat=2048m"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+      std::ofstream file("test_listen_bad.conf");
+      file << "server {\n"
+           << "    listen 8080 " << bad[i] << ";\n"
+           << "    root /var/www;\n"
+           << "}\n";
+      file.close();
+
+      ConfigParser parser("test_listen_bad.conf");
+      INFO(bad[i]);
+      REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    }
+    std::remove("test_listen_bad.conf");
+  }
+}
+
 TEST_CASE("Integration: Valid location paths",
           "[config][integration][location]") {
   SECTION("Root location") {
@@ -0,0 +1,71 @@
+#include <fstream>
+
+#include "../../lib/catch2/catch.hpp"
+#include "../../src/config/ConfigException.hpp"
+#include "../../src/config/ConfigStore.hpp"
+
+// ============================================================================
+// RELOAD: ConfigStore snapshots (SIGHUP)
+// ============================================================================
+
+static void writeConfig(const char* path, int port) {
+  std::ofstream file(path);
+  file << "server {\n"
+       << "    listen " << port << ";\n"
+       << "    root /var/www;\n"
+       << "}\n";
+}
+
+TEST_CASE("Reload: ConfigStore snapshots", "[config][reload]") {
+  const char* path = "test_reload.conf";
+
+  SECTION("Nothing is parsed until a reload is requested") {
+    writeConfig(path, 8080);
+    ConfigStore store(path);
+    REQUIRE(store.refresh(0) == 0);
+
+    ConfigSnapshot* snapshot = store.acquire();
+    REQUIRE(snapshot->getServers()[0].getPort() == 8080);
+    snapshot->release();
+  }
+
+  SECTION("Old snapshot stays valid while pinned") {
+    writeConfig(path, 8080);
+    ConfigStore store(path);
+    ConfigSnapshot* old = store.acquire();
+
+    writeConfig(path, 9090);
+    REQUIRE(store.refresh(1) == 1);
+    REQUIRE(store.refresh(1) == 1);  // same request handled once
+
+    ConfigSnapshot* current = store.acquire();
+    REQUIRE(current != old);
+    REQUIRE(current->getServers()[0].getPort() == 9090);
+    REQUIRE(old->getServers()[0].getPort() == 8080);
+    current->release();
+    old->release();
+  }
+
+  SECTION("Invalid file keeps the running configuration") {
+    writeConfig(path, 8080);
+    ConfigStore store(path);
+
+    std::ofstream broken(path);
+    broken << "server {\n    listen 8080\n";
+    broken.close();
+    REQUIRE(store.refresh(1) == 0);
+
+    ConfigSnapshot* snapshot = store.acquire();
+    REQUIRE(snapshot->getServers()[0].getPort() == 8080);
+    snapshot->release();
+  }
+
+  SECTION("Invalid initial file throws") {
+    std::ofstream broken(path);
+    broken << "server {\n";
+    broken.close();
+    REQUIRE_THROWS_AS(ConfigStore(path), ConfigException);
+  }
+
+  std::remove(path);
+}
@@ -0,0 +1,484 @@
+#include <fstream>
+
+#include "../../lib/catch2/catch.hpp"
+#include "../../src/config/ConfigException.hpp"
+#include "../../src/config/ConfigParser.hpp"
+
+// ============================================================================
+// GLOBAL CONTEXT: directives outside of every server { } block
+// ============================================================================
+
+TEST_CASE("Global: worker_threads directive", "[config][global]") {
+  SECTION("Default is a single reactor") {
+    std::ofstream file("test_global_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getWorkerThreads() == 1);
+    std::remove("test_global_default.conf");
+  }
+
+  SECTION("Explicit number before the server block") {
+    std::ofstream file("test_global_threads.conf");
+    file << "worker_threads 4;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_threads.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getWorkerThreads() == 4);
+    std::remove("test_global_threads.conf");
+  }
+
+  SECTION("auto resolves to at least one thread") {
+    std::ofstream file("test_global_auto.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n"
+         << "worker_threads auto;\n";
+    file.close();
+
+    ConfigParser parser("test_global_auto.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getWorkerThreads() >= 1);
+    std::remove("test_global_auto.conf");
+  }
+
+  SECTION("Zero threads is rejected") {
+    std::ofstream file("test_global_zero.conf");
+    file << "worker_threads 0;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_zero.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_zero.conf");
+  }
+
+  SECTION("Non numeric value is rejected") {
+    std::ofstream file("test_global_nan.conf");
+    file << "worker_threads many;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_nan.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_nan.conf");
+  }
+}
+
+TEST_CASE("Global: worker_processes directive", "[config][global]") {
+  SECTION("Default is a single process") {
+    std::ofstream file("test_global_proc_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_proc_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getWorkerProcesses() == 1);
+    std::remove("test_global_proc_default.conf");
+  }
+
+  SECTION("Combined with worker_threads") {
+    std::ofstream file("test_global_proc_threads.conf");
+    file << "worker_processes 2;\n"
+         << "worker_threads 3;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_proc_threads.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getWorkerProcesses() == 2);
+    REQUIRE(parser.getGlobalConfig().getWorkerThreads() == 3);
+    std::remove("test_global_proc_threads.conf");
+  }
+
+  SECTION("Out of range is rejected") {
+    std::ofstream file("test_global_proc_range.conf");
+    file << "worker_processes 1000;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_proc_range.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_proc_range.conf");
+  }
+}
+
+TEST_CASE("Global: edge_triggered directive", "[config][global]") {
+  SECTION("Off by default") {
+    std::ofstream file("test_global_et_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_et_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().isEdgeTriggered() == false);
+    std::remove("test_global_et_default.conf");
+  }
+
+  SECTION("on enables EPOLLET") {
+    std::ofstream file("test_global_et_on.conf");
+    file << "edge_triggered on;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_et_on.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().isEdgeTriggered() == true);
+    std::remove("test_global_et_on.conf");
+  }
+
+  SECTION("Invalid value is rejected") {
+    std::ofstream file("test_global_et_bad.conf");
+    file << "edge_triggered yes;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_et_bad.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_et_bad.conf");
+  }
+}
+
+TEST_CASE("Global: event_backend directive", "[config][global]") {
+  SECTION("epoll by default") {
+    std::ofstream file("test_global_eb_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_eb_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getEventBackend() == "epoll");
+    std::remove("test_global_eb_default.conf");
+  }
+
+  SECTION("io_uring is accepted") {
+    std::ofstream file("test_global_eb_uring.conf");
+    file << "event_backend io_uring;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_eb_uring.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getEventBackend() == "io_uring");
+    std::remove("test_global_eb_uring.conf");
+  }
+
+  SECTION("Unknown backend is rejected") {
+    std::ofstream file("test_global_eb_bad.conf");
+    file << "event_backend kqueue;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_eb_bad.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_eb_bad.conf");
+  }
+}
+
+TEST_CASE("Global: max_connections directive", "[config][global]") {
+  SECTION("Defaults to 1024") {
+    std::ofstream file("test_global_mc_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_mc_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getMaxConnections() == 1024);
+    std::remove("test_global_mc_default.conf");
+  }
+
+  SECTION("Explicit value") {
+    std::ofstream file("test_global_mc_value.conf");
+    file << "max_connections 4096;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_mc_value.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getMaxConnections() == 4096);
+    std::remove("test_global_mc_value.conf");
+  }
+
+  SECTION("Zero is rejected") {
+    std::ofstream file("test_global_mc_zero.conf");
+    file << "max_connections 0;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_mc_zero.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_mc_zero.conf");
+  }
+}
+
+TEST_CASE("Global: timeout directives", "[config][global][timeout]") {
+  SECTION("client_timeout defaults to 60 seconds") {
+    std::ofstream file("test_global_to_default.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_default.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getClientTimeout() == 60);
+    REQUIRE(parser.getServers()[0].getCgiTimeout() == 60);
+    std::remove("test_global_to_default.conf");
+  }
+
+  SECTION("client_timeout and cgi_timeout accept an 's' suffix") {
+    std::ofstream file("test_global_to_values.conf");
+    file << "client_timeout 15s;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "    cgi_timeout 5;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_values.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getClientTimeout() == 15);
+    REQUIRE(parser.getServers()[0].getCgiTimeout() == 5);
+    std::remove("test_global_to_values.conf");
+  }
+
+  SECTION("Zero timeout is rejected") {
+    std::ofstream file("test_global_to_zero.conf");
+    file << "client_timeout 0;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_zero.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_to_zero.conf");
+  }
+
+  SECTION("Phase timeouts fall back to client_timeout") {
+    std::ofstream file("test_global_to_phase.conf");
+    file << "client_timeout 20s;\n"
+         << "client_header_timeout 5s;\n"
+         << "keepalive_timeout 8;\n"
+         << "client_body_min_rate 1k;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_phase.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    const GlobalConfig& global = parser.getGlobalConfig();
+    REQUIRE(global.getClientHeaderTimeout() == 5);
+    REQUIRE(global.getKeepaliveTimeout() == 8);
+    REQUIRE(global.getClientBodyTimeout() == 20);
+    REQUIRE(global.getSendTimeout() == 20);
+    REQUIRE(global.getClientBodyMinRate() == 1024);
+    std::remove("test_global_to_phase.conf");
+  }
+
+  SECTION("Zero phase timeout is rejected") {
+    std::ofstream file("test_global_to_phase_zero.conf");
+    file << "send_timeout 0;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_phase_zero.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_to_phase_zero.conf");
+  }
+
+  SECTION("Duplicate cgi_timeout in server is rejected") {
+    std::ofstream file("test_global_to_dup.conf");
+    file << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "    cgi_timeout 5;\n"
+         << "    cgi_timeout 6;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_to_dup.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_to_dup.conf");
+  }
+}
+
+TEST_CASE("Global: client_body_buffer_size", "[config][global]") {
+  SECTION("Default keeps 16k bodies in memory") {
+    GlobalConfig global;
+    REQUIRE(global.getClientBodyBufferSize() == 16384);
+  }
+
+  SECTION("Size suffixes are accepted") {
+    std::ofstream file("test_global_bodybuf.conf");
+    file << "client_body_buffer_size 64k;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_bodybuf.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getClientBodyBufferSize() == 65536);
+    std::remove("test_global_bodybuf.conf");
+  }
+
+  SECTION("Zero is rejected") {
+    std::ofstream file("test_global_bodybuf_zero.conf");
+    file << "client_body_buffer_size 0;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_bodybuf_zero.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_bodybuf_zero.conf");
+  }
+}
+
+TEST_CASE("Global: header limits", "[config][global]") {
+  SECTION("Defaults match nginx (4 8k) and 100 headers") {
+    GlobalConfig global;
+    REQUIRE(global.getClientHeaderBufferSize() == 8192);
+    REQUIRE(global.getClientHeaderMaxSize() == 4 * 8192);
+    REQUIRE(global.getClientMaxHeaderCount() == 100);
+  }
+
+  SECTION("Directives are parsed") {
+    std::ofstream file("test_global_headers.conf");
+    file << "large_client_header_buffers 2 1k;\n"
+         << "client_max_header_count 20;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_headers.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getClientHeaderBufferSize() == 1024);
+    REQUIRE(parser.getGlobalConfig().getClientHeaderMaxSize() == 2048);
+    REQUIRE(parser.getGlobalConfig().getClientMaxHeaderCount() == 20);
+    std::remove("test_global_headers.conf");
+  }
+
+  SECTION("Missing size is rejected") {
+    std::ofstream file("test_global_headers_bad.conf");
+    file << "large_client_header_buffers 4;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_headers_bad.conf");
+    REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+    std::remove("test_global_headers_bad.conf");
+  }
+}
+
+TEST_CASE("Global: pipeline_depth", "[config][global]") {
+  SECTION("Default is 32") {
+    GlobalConfig global;
+    REQUIRE(global.getPipelineDepth() == 32);
+  }
+
+  SECTION("Value is parsed") {
+    std::ofstream file("test_global_pipeline.conf");
+    file << "pipeline_depth 8;\n"
+         << "server {\n"
+         << "    listen 8080;\n"
+         << "    root /var/www;\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser("test_global_pipeline.conf");
+    REQUIRE_NOTHROW(parser.parse());
+    REQUIRE(parser.getGlobalConfig().getPipelineDepth() == 8);
+    std::remove("test_global_pipeline.conf");
+  }
+
+  SECTION("Zero is rejected") {
+    GlobalConfig global;
+    REQUIRE_THROWS_AS(global.setPipelineDepth(0), ConfigException);
+  }
+}
+
+TEST_CASE("Global: unknown directive outside server block",
+          "[config][global]") {
+  std::ofstream file("test_global_unknown.conf");
+  file << "foo bar;\n"
+       << "server {\n"
+       << "    listen 8080;\n"
+       << "    root /var/www;\n"
+       << "}\n";
+  file.close();
+
+  ConfigParser parser("test_global_unknown.conf");
+  REQUIRE_THROWS_AS(parser.parse(), ConfigException);
+  std::remove("test_global_unknown.conf");
+}
@@ -0,0 +1,323 @@
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../lib/catch2/catch.hpp"
+#include "../../src/http/FormUpload.hpp"
+#include "../../src/http/MultipartParser.hpp"
+
+// ============================================================================
+// MULTIPART: every body is fed split at each byte offset (and one byte at a
+// time), the result must not depend on where the chunks end
+// ============================================================================
+
+namespace {
+
+struct RecordedPart {
+  MultipartPart head;
+  std::string data;
+  bool ended;
+};
+
+// Handler that keeps everything the parser hands out
+class Recorder : public MultipartHandler {
+ public:
+  std::vector<RecordedPart> parts;
+
+  bool onPartBegin(const MultipartPart& part) {
+    RecordedPart rec;
+    rec.head = part;
+    rec.ended = false;
+    parts.push_back(rec);
+    return true;
+  }
+  bool onPartData(const char* data, std::size_t len) {
+    parts.back().data.append(data, len);
+    return true;
+  }
+  bool onPartEnd() {
+    parts.back().ended = true;
+    return true;
+  }
+};
+
+const char* const BOUNDARY = "----WebKitFormBoundary7MA4YWxk";
+
+std::string delimiter() { return std::string("--") + BOUNDARY; }
+
+std::string filePart(const std::string& name, const std::string& filename,
+                     const std::string& data) {
+  return delimiter() + "\r\n" +
+         "Content-Disposition: form-data; name=\"" + name +
+         "\"; filename=\"" + filename + "\"\r\n" +
+         "Content-Type: application/octet-stream\r\n\r\n" + data + "\r\n";
+}
+
+std::string fieldPart(const std::string& name, const std::string& value) {
+  return delimiter() + "\r\n" + "Content-Disposition: form-data; name=\"" +
+         name + "\"\r\n\r\n" + value + "\r\n";
+}
+
+std::string closing() { return delimiter() + "--\r\n"; }
+
+// File data with "\r\n--" sequences that are not the delimiter: a shorter
+// boundary, the boundary with one byte changed, and a lone "\r"
+std::string trickyData() {
+  std::string boundary(BOUNDARY);
+  std::string changed = boundary;
+  changed[changed.size() - 1] = 'Z';
+  return std::string("line1\r\n--") + boundary.substr(0, 10) + "\r\n" +
+         "\r\n--" + changed + "\r\nmid\rdle\r\n-" + "\r\n--";
+}
+
+std::vector<RecordedPart> parseSplit(const std::string& body, size_t at,
+                                     bool& done, bool& error) {
+  Recorder recorder;
+  MultipartParser parser(BOUNDARY, recorder);
+  parser.feed(body.data(), at);
+  parser.feed(body.data() + at, body.size() - at);
+  done = parser.isDone();
+  error = parser.hasError();
+  return recorder.parts;
+}
+
+std::vector<RecordedPart> parseBytewise(const std::string& body, bool& done,
+                                        bool& error) {
+  Recorder recorder;
+  MultipartParser parser(BOUNDARY, recorder);
+  for (size_t i = 0; i < body.size(); ++i) parser.feed(&body[i], 1);
+  done = parser.isDone();
+  error = parser.hasError();
+  return recorder.parts;
+}
+
+std::string makeTempDir() {
+  char name[] = "/tmp/webserv-unit-XXXXXX";
+  REQUIRE(mkdtemp(name) != NULL);
+  return name;
+}
+
+std::vector<std::string> listDir(const std::string& dir) {
+  std::vector<std::string> names;
+  DIR* d = opendir(dir.c_str());
+  if (!d) return names;
+  while (struct dirent* entry = readdir(d)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") names.push_back(name);
+  }
+  closedir(d);
+  return names;
+}
+
+void removeDir(const std::string& dir) {
+  std::vector<std::string> names = listDir(dir);
+  for (size_t i = 0; i < names.size(); ++i)
+    std::remove((dir + "/" + names[i]).c_str());
+  rmdir(dir.c_str());
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  std::ostringstream oss;
+  oss << in.rdbuf();
+  return oss.str();
+}
+
+}  // namespace
+
+TEST_CASE("Multipart: boundary from Content-Type", "[http][multipart]") {
+  std::string boundary;
+
+  SECTION("Plain and quoted parameter") {
+    REQUIRE(MultipartParser::boundaryFrom(
+        "multipart/form-data; boundary=abc123", boundary));
+    REQUIRE(boundary == "abc123");
+    REQUIRE(MultipartParser::boundaryFrom(
+        "Multipart/Form-Data; charset=utf-8; boundary=\"a b;c\"", boundary));
+    REQUIRE(boundary == "a b;c");
+  }
+
+  SECTION("Other types or a missing boundary are not forms") {
+    REQUIRE_FALSE(MultipartParser::boundaryFrom("text/plain", boundary));
+    REQUIRE_FALSE(
+        MultipartParser::boundaryFrom("multipart/form-data", boundary));
+    REQUIRE_FALSE(
+        MultipartParser::boundaryFrom("multipart/mixed; boundary=x", boundary));
+    REQUIRE_FALSE(MultipartParser::boundaryFrom(
+        "multipart/form-data; boundary=" + std::string(71, 'a'), boundary));
+  }
+}
+
+TEST_CASE("Multipart: body split at every offset", "[http][multipart]") {
+  std::string first = trickyData();
+  std::string second(3000, '\0');
+  for (size_t i = 0; i < second.size(); ++i)
+    second[i] = static_cast<char>(i * 7);
+  std::string body = "preamble is ignored\r\n" +
+                     filePart("a", "one.bin", first) +
+                     fieldPart("note", "plain text") +
+                     filePart("b", "two.txt", second) + closing() +
+                     "epilogue is ignored";
+
+  for (size_t at = 0; at <= body.size(); ++at) {
+    bool done = false;
+    bool error = false;
+    std::vector<RecordedPart> parts = parseSplit(body, at, done, error);
+    INFO("split at " << at);
+    REQUIRE(done);
+    REQUIRE_FALSE(error);
+    REQUIRE(parts.size() == 3);
+    REQUIRE(parts[0].head.filename == "one.bin");
+    REQUIRE(parts[0].data == first);
+    REQUIRE(parts[0].ended);
+    REQUIRE_FALSE(parts[1].head.hasFilename);
+    REQUIRE(parts[1].head.name == "note");
+    REQUIRE(parts[1].data == "plain text");
+    REQUIRE(parts[2].head.filename == "two.txt");
+    REQUIRE(parts[2].head.contentType == "application/octet-stream");
+    REQUIRE(parts[2].data == second);
+  }
+
+  bool done = false;
+  bool error = false;
+  std::vector<RecordedPart> parts = parseBytewise(body, done, error);
+  REQUIRE(done);
+  REQUIRE(parts.size() == 3);
+  REQUIRE(parts[0].data == first);
+  REQUIRE(parts[2].data == second);
+}
+
+TEST_CASE("Multipart: transport padding after the delimiter",
+          "[http][multipart]") {
+  std::string body = delimiter() + " \t \r\n" +
+                     "Content-Disposition: form-data; name=\"f\"; "
+                     "filename=\"p.txt\"\r\n\r\npadded\r\n" +
+                     closing();
+
+  for (size_t at = 0; at <= body.size(); ++at) {
+    bool done = false;
+    bool error = false;
+    std::vector<RecordedPart> parts = parseSplit(body, at, done, error);
+    INFO("split at " << at);
+    REQUIRE(done);
+    REQUIRE_FALSE(error);
+    REQUIRE(parts.size() == 1);
+    REQUIRE(parts[0].data == "padded");
+  }
+}
+
+TEST_CASE("Multipart: malformed bodies", "[http][multipart]") {
+  bool done = false;
+  bool error = false;
+
+  SECTION("Missing closing delimiter never completes") {
+    std::string body = filePart("a", "x.bin", "data");
+    for (size_t at = 0; at <= body.size(); ++at) {
+      parseSplit(body, at, done, error);
+      INFO("split at " << at);
+      REQUIRE_FALSE(done);
+    }
+  }
+
+  SECTION("Garbage after the delimiter") {
+    std::string body = delimiter() + "xx\r\n\r\n" + closing();
+    parseSplit(body, body.size() / 2, done, error);
+    REQUIRE(error);
+    REQUIRE_FALSE(done);
+  }
+
+  SECTION("Part headers above MAX_PART_HEADER") {
+    std::string body = delimiter() + "\r\n" +
+                       "Content-Disposition: form-data; name=\"a\"\r\n" +
+                       "X-Long: " +
+                       std::string(MultipartParser::MAX_PART_HEADER, 'h') +
+                       "\r\n\r\ndata\r\n" + closing();
+    std::vector<RecordedPart> parts =
+        parseSplit(body, body.size() / 3, done, error);
+    REQUIRE(error);
+    REQUIRE_FALSE(done);
+    REQUIRE(parts.empty());
+  }
+
+  SECTION("Part that is not form-data") {
+    std::string body = delimiter() + "\r\n" +
+                       "Content-Disposition: attachment; filename=\"a\"\r\n" +
+                       "\r\ndata\r\n" + closing();
+    parseSplit(body, 5, done, error);
+    REQUIRE(error);
+  }
+}
+
+TEST_CASE("FormUpload: files land in upload_store", "[http][multipart]") {
+  std::string dir = makeTempDir();
+
+  SECTION("Multiple files, committed under their own names") {
+    std::string body = filePart("a", "one.bin", trickyData()) +
+                       fieldPart("note", "ignored") +
+                       filePart("b", "two.txt", "second file") + closing();
+    {
+      FormUpload form(dir, BOUNDARY);
+      size_t half = body.size() / 2;
+      REQUIRE(form.write(body.data(), half));
+      REQUIRE(form.write(body.data() + half, body.size() - half));
+      REQUIRE(form.isComplete());
+      REQUIRE(form.fileCount() == 2);
+      REQUIRE(form.commit());
+    }
+    REQUIRE(listDir(dir).size() == 2);
+    REQUIRE(readFile(dir + "/one.bin") == trickyData());
+    REQUIRE(readFile(dir + "/two.txt") == "second file");
+  }
+
+  SECTION("Client paths are reduced to their last component") {
+    // Quoted-string: "\\" on the wire is one backslash
+    const char* names[] = {"../../x", "..\\\\..\\\\y", "/etc/z", "a/b/../w"};
+    std::string body;
+    for (size_t i = 0; i < 4; ++i) body += filePart("f", names[i], names[i]);
+    body += closing();
+    {
+      FormUpload form(dir, BOUNDARY);
+      REQUIRE(form.write(body.data(), body.size()));
+      REQUIRE(form.commit());
+    }
+    std::vector<std::string> files = listDir(dir);
+    REQUIRE(files.size() == 4);
+    REQUIRE(readFile(dir + "/x") == "../../x");
+    REQUIRE(readFile(dir + "/y") == names[1]);
+    REQUIRE(readFile(dir + "/z") == "/etc/z");
+    REQUIRE(readFile(dir + "/w") == "a/b/../w");
+  }
+
+  SECTION("Names that are only dots get a generated one") {
+    std::string body = filePart("f", "..", "dots") + closing();
+    {
+      FormUpload form(dir, BOUNDARY);
+      REQUIRE(form.write(body.data(), body.size()));
+      REQUIRE(form.commit());
+    }
+    std::vector<std::string> files = listDir(dir);
+    REQUIRE(files.size() == 1);
+    REQUIRE(files[0].compare(0, 14, "uploaded_file_") == 0);
+  }
+
+  SECTION("Missing closing delimiter: not complete, nothing kept") {
+    // StaticPathHandler answers 400 when isComplete() is false
+    std::string body = filePart("a", "cut.bin", "partial");
+    {
+      FormUpload form(dir, BOUNDARY);
+      REQUIRE(form.write(body.data(), body.size()));
+      REQUIRE_FALSE(form.isComplete());
+      REQUIRE_FALSE(form.commit());
+    }
+    REQUIRE(listDir(dir).empty());
+  }
+
+  removeDir(dir);
+}